@@ -4,6 +4,11 @@
 
 #include "BaseGameInstance.h"
 #include "BaseGameState.h"
+#include "FloatingTextSubsystem.h"
+#include "GameplayEventSubsystem.h"
+#include "GameplayLLMTags.h"
+#include "GameplayMetrics.h"
+#include "LeaderboardSubsystem.h"
 #include "Engine/LocalPlayer.h"
 #include "Camera/CameraComponent.h"
 #include "Components/CapsuleComponent.h"
@@ -16,7 +21,10 @@
 #include "InputActionValue.h"
 #include "Blueprint/UserWidget.h"
 #include "Components/Border.h"
+#include "Blueprint/WidgetTree.h"
 #include "Components/Button.h"
+#include "Components/CanvasPanel.h"
+#include "Components/CanvasPanelSlot.h"
 #include "Components/ProgressBar.h"
 #include "Components/TextBlock.h"
 #include "Components/WidgetComponent.h"
@@ -95,6 +103,8 @@ UUserWidget* ACH8_UICharacter::GetHUDWidget() const
 
 void ACH8_UICharacter::ShowGameHUD()
 {
+	LLM_SCOPE_BYTAG(CH8UI);
+
 	if (HUDWidgetInstance)
 	{
 		HUDWidgetInstance->RemoveFromParent();
@@ -132,6 +142,8 @@ void ACH8_UICharacter::ShowGameHUD()
 
 void ACH8_UICharacter::ShowMainMenu(bool bIsRestart)
 {
+	LLM_SCOPE_BYTAG(CH8UI);
+
 	if (HUDWidgetInstance)
 	{
 		HUDWidgetInstance->RemoveFromParent();
@@ -196,16 +208,57 @@ void ACH8_UICharacter::ShowMainMenu(bool bIsRestart)
 					}
 				}
 			}
+
+			// 리더보드 상위 10개 (색인만 읽으므로 시작 화면에서도 바로 표시됨)
+			if (UTextBlock* LeaderboardText = FindOrCreateLeaderboardText())
+			{
+				if (const ULeaderboardSubsystem* Leaderboard = UGameInstance::GetSubsystem<ULeaderboardSubsystem>(UGameplayStatics::GetGameInstance(this)))
+				{
+					LeaderboardText->SetText(FText::FromString(Leaderboard->FormatTopEntries(10)));
+				}
+			}
 		}
 	}
 }
 
+UTextBlock* ACH8_UICharacter::FindOrCreateLeaderboardText()
+{
+	if (!MainMenuWidgetInstance)
+	{
+		return nullptr;
+	}
+
+	if (UTextBlock* LeaderboardText = Cast<UTextBlock>(MainMenuWidgetInstance->GetWidgetFromName(TEXT("LeaderboardText"))))
+	{
+		return LeaderboardText;
+	}
+
+	// WBP_MainMenu 에 자리가 없으면 오른쪽 위에 직접 추가
+	UCanvasPanel* RootCanvas = MainMenuWidgetInstance->WidgetTree ? Cast<UCanvasPanel>(MainMenuWidgetInstance->WidgetTree->RootWidget) : nullptr;
+	if (!RootCanvas)
+	{
+		UE_LOG(LogTemplateCharacter, Warning, TEXT("'%s' has no LeaderboardText and no root canvas to add one to, leaderboard is not shown"), *GetNameSafe(MainMenuWidgetClass));
+		return nullptr;
+	}
+
+	UE_LOG(LogTemplateCharacter, Warning, TEXT("'%s' has no LeaderboardText, adding one at runtime"), *GetNameSafe(MainMenuWidgetClass));
+	UTextBlock* LeaderboardText = MainMenuWidgetInstance->WidgetTree->ConstructWidget<UTextBlock>(UTextBlock::StaticClass(), TEXT("LeaderboardText"));
+	LeaderboardText->SetJustification(ETextJustify::Right);
+	if (UCanvasPanelSlot* CanvasSlot = RootCanvas->AddChildToCanvas(LeaderboardText))
+	{
+		CanvasSlot->SetAnchors(FAnchors(1.0f, 0.0f));
+		CanvasSlot->SetAlignment(FVector2D(1.0f, 0.0f));
+		CanvasSlot->SetPosition(FVector2D(-40.0f, 40.0f));
+		CanvasSlot->SetAutoSize(true);
+	}
+	return LeaderboardText;
+}
+
 void ACH8_UICharacter::StartGame()
 {
 	if (UBaseGameInstance* BaseGameInstance = Cast<UBaseGameInstance>(UGameplayStatics::GetGameInstance(this)))
 	{
-		BaseGameInstance->CurrentLevelIndex = 0;
-		BaseGameInstance->TotalScore = 0;
+		BaseGameInstance->BeginRun();
 	}
 
 	UGameplayStatics::OpenLevel(GetWorld(), FName("BasicLevel"));
@@ -213,6 +266,8 @@ void ACH8_UICharacter::StartGame()
 
 void ACH8_UICharacter::TogglePauseMenu()
 {
+	LLM_SCOPE_BYTAG(CH8UI);
+
 	FString CurrentMapName = GetWorld()->GetMapName();
 	if (CurrentMapName.Contains("MenuLevel"))
 	{
@@ -321,6 +376,8 @@ void ACH8_UICharacter::AddHealth(float Amount)
 {
 	Health = FMath::Clamp(Health + Amount, 0.0f, MaxHealth);
 	UpdateOverheadHP();
+
+	UGameplayEventSubsystem::Record(this, EGameplayEventType::Heal, FMath::RoundToInt(Amount), FMath::RoundToInt(Health));
 }
 
 float ACH8_UICharacter::TakeDamage(float DamageAmount, FDamageEvent const& DamageEvent, AController* EventInstigator, AActor* DamageCauser)
@@ -330,6 +387,16 @@ float ACH8_UICharacter::TakeDamage(float DamageAmount, FDamageEvent const& Damag
 	Health = FMath::Clamp(Health - DamageAmount, 0.0f, MaxHealth);
 	UpdateOverheadHP();
 
+	UGameplayEventSubsystem::Record(this, EGameplayEventType::Damage, FMath::RoundToInt(DamageAmount), FMath::RoundToInt(Health));
+#if !UE_BUILD_SHIPPING
+	CH8Metrics::RecordDamage(DamageAmount);
+#endif
+
+	if (UFloatingTextSubsystem* FloatingText = GetWorld()->GetSubsystem<UFloatingTextSubsystem>())
+	{
+		FloatingText->AddText(EFloatingTextKind::Damage, FMath::RoundToInt(DamageAmount), GetActorLocation() + FVector(0.0f, 0.0f, GetSimpleCollisionHalfHeight()));
+	}
+
 	if (Health <= 0.0f)
 	{
 		OnDeath();
@@ -342,6 +409,7 @@ void ACH8_UICharacter::OnDeath()
 {
 	if (ABaseGameState* GameState = GetWorld()->GetGameState<ABaseGameState>())
 	{
+		UGameplayEventSubsystem::Record(this, EGameplayEventType::Death, GameState->CurrentLevelIndex, GameState->CurrentWave);
 		GameState->OnGameOver();
 	}
 }
@@ -355,7 +423,20 @@ void ACH8_UICharacter::UpdateOverheadHP()
 	
 	if (UTextBlock* HPText = Cast<UTextBlock>(OverheadWidgetInstance->GetWidgetFromName(TEXT("OverHeadHP"))))
 	{
-		HPText->SetText(FText::FromString(FString::Printf(TEXT("%.0f / %.0f"), Health, MaxHealth)));
+		if (OverheadHPTextsMaxHealth != MaxHealth)
+		{
+			LLM_SCOPE_BYTAG(CH8UI);
+			OverheadHPTextsMaxHealth = MaxHealth;
+			const int32 NumTexts = FMath::Max(FMath::RoundToInt(MaxHealth), 0) + 1;
+			OverheadHPTexts.Reset(NumTexts);
+			for (int32 HP = 0; HP < NumTexts; HP++)
+			{
+				OverheadHPTexts.Add(FText::FromString(FString::Printf(TEXT("%d / %.0f"), HP, MaxHealth)));
+			}
+		}
+
+		const int32 HPIndex = FMath::Clamp(FMath::RoundToInt(Health), 0, OverheadHPTexts.Num() - 1);
+		HPText->SetText(OverheadHPTexts[HPIndex]);
 	}
 	
 	if (UProgressBar* HPBar = Cast<UProgressBar>(OverheadWidgetInstance->GetWidgetFromName(TEXT("OverHeadHPBar"))))
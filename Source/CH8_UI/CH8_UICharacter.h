@@ -70,6 +70,8 @@ public:
 	// 현재 체력을 가져오는 함수
 	UFUNCTION(BlueprintPure, Category = "Health")
 	int32 GetHealth() const;
+	// 체력이 0 이하 (OnDeath 가 이미 불렸음)
+	bool IsDead() const { return Health <= 0.0f; }
 	// 체력을 회복시키는 함수
 	UFUNCTION(BlueprintCallable, Category = "Health")
 	void AddHealth(float Amount);
@@ -109,6 +111,13 @@ protected:
 	virtual void OnDeath();
 	UFUNCTION(BlueprintCallable, Category = "Health")
 	void UpdateOverheadHP();
+
+	// 체력 1 단위의 머리 위 체력 문구. 맞거나 회복할 때마다 문자열을 만들지 않도록 최대 체력이 바뀔 때만 다시 만듦
+	TArray<FText> OverheadHPTexts;
+	float OverheadHPTextsMaxHealth = 0.0f;
+
+	// 메인 메뉴의 LeaderboardText 를 찾고, 위젯 블루프린트에 없으면 루트 캔버스에 만들어 넣음
+	class UTextBlock* FindOrCreateLeaderboardText();
 	
 	// 데미지 처리 함수 - 외부로부터 데미지를 받을 때 호출됨
 	// 또는 AActor의 TakeDamage()를 오버라이드
@@ -2,15 +2,68 @@
 
 
 #include "BaseGameInstance.h"
+#include "GameplayEventSubsystem.h"
+#include "GameplayMetrics.h"
 
 UBaseGameInstance::UBaseGameInstance()
 {
 	TotalScore = 0;
 	CurrentLevelIndex = 0;
+	RunSeed = 0;
+	RunStartTime = 0.0;
+	bRunRecorded = false;
+}
+
+void UBaseGameInstance::Init()
+{
+	Super::Init();
+
+#if !UE_BUILD_SHIPPING
+	CH8Metrics::Startup();
+#endif
+}
+
+void UBaseGameInstance::Shutdown()
+{
+#if !UE_BUILD_SHIPPING
+	CH8Metrics::Shutdown();
+#endif
+
+	Super::Shutdown();
 }
 
 void UBaseGameInstance::AddToScore(int32 Amount)
 {
 	TotalScore += Amount;
-	UE_LOG(LogTemp, Warning, TEXT("Total Score Updated: %d"), TotalScore);
+	if (CurrentLevelIndex >= 0)
+	{
+		if (LevelScores.Num() <= CurrentLevelIndex)
+		{
+			LevelScores.SetNumZeroed(CurrentLevelIndex + 1);
+		}
+		LevelScores[CurrentLevelIndex] += Amount;
+	}
+	if (UGameplayEventSubsystem* EventSubsystem = GetSubsystem<UGameplayEventSubsystem>())
+	{
+		EventSubsystem->Record(EGameplayEventType::Score, Amount, TotalScore);
+	}
+#if !UE_BUILD_SHIPPING
+	CH8Metrics::SetTotalScore(TotalScore);
+#endif
+}
+
+void UBaseGameInstance::BeginRun()
+{
+	TotalScore = 0;
+	CurrentLevelIndex = 0;
+	LevelScores.Reset();
+	LevelScores.SetNumZeroed(1);
+#if !UE_BUILD_SHIPPING
+	CH8Metrics::SetTotalScore(TotalScore);
+#endif
+	RunStartTime = FPlatformTime::Seconds();
+	bRunRecorded = false;
+
+	// 웨이브 계획 시드는 (RunSeed, 레벨, 웨이브) 에서 만들어지므로 같은 시드면 같은 계획이 나옴
+	RunSeed = static_cast<int32>(FPlatformTime::Cycles() ^ static_cast<uint32>(FDateTime::UtcNow().GetTicks()));
 }
\ No newline at end of file
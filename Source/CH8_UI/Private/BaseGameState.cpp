@@ -2,11 +2,23 @@
 #include "BaseGameInstance.h"
 #include "CH8_UI/CH8_UICharacter.h"
 #include "SpawnVolume.h"
-#include "CoinItem.h"
+#include "SpawnRecordSubsystem.h"
 #include "BaseItem.h"
+#include "WaveSpawnPlannerSubsystem.h"
+#include "GameplayLLMTags.h"
+#include "WaveTelemetrySubsystem.h"
+#include "SoakRunSubsystem.h"
+#include "LeaderboardSubsystem.h"
+#include "RivalCollectorSubsystem.h"
+#include "GameplayEventSubsystem.h"
+#include "GameplayDebug.h"
+#include "GameplayMetrics.h"
+#include "GameplayAllocCheck.h"
+#include "EngineUtils.h"
 #include "Kismet/GameplayStatics.h"
 #include "Components/TextBlock.h"
 #include "Blueprint/UserWidget.h"
+#include "Misc/ScopeExit.h"
 
 ABaseGameState::ABaseGameState()
 {
@@ -25,6 +37,8 @@ void ABaseGameState::BeginPlay()
 {
 	Super::BeginPlay();
 
+	RegisterTimerHandlers();
+
 	FString CurrentMapName = GetWorld()->GetMapName();
 	if (CurrentMapName.Contains("MenuLevel"))
 	{
@@ -33,13 +47,7 @@ void ABaseGameState::BeginPlay()
 
 	StartLevel();
 
-	GetWorldTimerManager().SetTimer(
-		HUDUpdateTimerHandle,
-		this,
-		&ABaseGameState::UpdateHUD,
-		0.1f,
-		true
-	);
+	ScheduleTimer(HUDUpdateTimerHandle, 0.1f, EGameplayTimerKind::HUDRefresh);
 }
 
 int32 ABaseGameState::GetScore() const
@@ -49,6 +57,8 @@ int32 ABaseGameState::GetScore() const
 
 void ABaseGameState::AddScore(int32 Amount)
 {
+	Rules.AddScore(Amount);
+
 	if (UGameInstance* GameInstance = GetGameInstance())
 	{
 		UBaseGameInstance* SpartaGameInstance = Cast<UBaseGameInstance>(GameInstance);
@@ -66,16 +76,28 @@ void ABaseGameState::StartLevel()
 		PlayerCharacter->ShowGameHUD();
 	}
 
+	int32 LevelIndex = CurrentLevelIndex;
 	if (UGameInstance* GameInstance = GetGameInstance())
 	{
 		UBaseGameInstance* SpartaGameInstance = Cast<UBaseGameInstance>(GameInstance);
 		if (SpartaGameInstance)
 		{
-			CurrentLevelIndex = SpartaGameInstance->CurrentLevelIndex;
+			LevelIndex = SpartaGameInstance->CurrentLevelIndex;
 		}
 	}
 
-	CurrentWave = 0;
+	bGameOver = false;
+	Rules.Configure(MakeRulesConfig());
+	Rules.StartLevel(LevelIndex);
+	SyncFromRules();
+	BuildHUDTexts();
+#if !UE_BUILD_SHIPPING
+	CH8AllocCheck::OnLevelStarted();
+#endif
+	if (URivalCollectorSubsystem* Rivals = GetWorld()->GetSubsystem<URivalCollectorSubsystem>())
+	{
+		Rivals->OnLevelStarted();
+	}
 	StartWave();
 }
 
@@ -85,6 +107,7 @@ void ABaseGameState::StartWave()
 
 	SpawnedCoinCount = 0;
 	CollectedCoinCount = 0;
+	int32 WaveCoinCount = 0;
 
 	if (ACH8_UICharacter* PlayerCharacter = Cast<ACH8_UICharacter>(UGameplayStatics::GetPlayerCharacter(GetWorld(), 0)))
 	{
@@ -95,80 +118,119 @@ void ABaseGameState::StartWave()
 				WaveText->SetText(FText::FromString(FString::Printf(TEXT("Wave %d Start!"), CurrentWave + 1)));
 				WaveText->SetVisibility(ESlateVisibility::Visible);
 
-				GetWorldTimerManager().SetTimer(
-					WaveTextTimerHandle,
-					this,
-					&ABaseGameState::HideWaveText,
-					2.0f,
-					false
-				);
+				ScheduleTimer(WaveTextTimerHandle, 2.0f, EGameplayTimerKind::WaveText);
 			}
 		}
 	}
 
-	int32 ItemToSpawn = 40;
-	if (ItemsPerWave.IsValidIndex(CurrentWave))
-	{
-		ItemToSpawn = ItemsPerWave[CurrentWave];
-	}
-
-	TArray<AActor*> FoundVolumes;
-	UGameplayStatics::GetAllActorsOfClass(GetWorld(), ASpawnVolume::StaticClass(), FoundVolumes);
+	const int32 ItemToSpawn = GetItemsToSpawn(Rules.GetWaveIndex());
+#if !UE_BUILD_SHIPPING
+	const double SpawnStartTime = FPlatformTime::Seconds();
+#endif
 
-	if (FoundVolumes.Num() > 0)
+	UWaveSpawnPlannerSubsystem* SpawnPlanner = GetWorld()->GetSubsystem<UWaveSpawnPlannerSubsystem>();
+	if (SpawnPlanner)
 	{
-		ASpawnVolume* SpawnVolume = Cast<ASpawnVolume>(FoundVolumes[0]);
-		if (SpawnVolume)
+		CH8_ALLOC_SCOPE(Spawn);
+
+		// 첫 번째 볼륨만 사용 (배열에 모으지 않고 바로 찾음)
+		TActorIterator<ASpawnVolume> VolumeIt(GetWorld());
+		if (ASpawnVolume* SpawnVolume = VolumeIt ? *VolumeIt : nullptr)
 		{
-			for (int32 i = 0; i < ItemToSpawn; i++)
+			// 웨이브 아이템 구성과 위치는 지난 웨이브 동안 워커에서 미리 정해둔 계획을 사용 (없으면 지금 계산)
+			// 실제 스폰은 기록 시스템이 스트리밍 셀 로드 상태와 거버너의 프레임 예산에 맞춰 나눠서 함
+			const FWaveSpawnPlan& Plan = SpawnPlanner->AcquirePlan(SpawnVolume, Rules.GetLevelIndex(), Rules.GetWaveIndex(), ItemToSpawn);
+			WaveCoinCount = Plan.CoinCount;
+
+			if (USpawnRecordSubsystem* SpawnRecords = GetWorld()->GetSubsystem<USpawnRecordSubsystem>())
+			{
+				SpawnRecords->StartWave(SpawnVolume, Plan.Rows, Plan.Locations);
+			}
+			else
 			{
-				AActor* SpawnedActor = SpawnVolume->SpawnRandomItem();
-				if (SpawnedActor && SpawnedActor->IsA(ACoinItem::StaticClass()))
+				for (int32 i = 0; i < Plan.Rows.Num(); i++)
 				{
-					SpawnedCoinCount++;
+					SpawnVolume->SpawnItemFromRow(*Plan.Rows[i], Plan.Locations[i]);
 				}
 			}
+
+			// 같은 레벨에 다음 웨이브가 있으면 이번 웨이브가 진행되는 동안 계획을 미리 계산
+			const int32 NextWaveIndex = Rules.GetWaveIndex() + 1;
+			if (NextWaveIndex < Rules.GetConfig().MaxWaves)
+			{
+				SpawnPlanner->RequestPlan(SpawnVolume, Rules.GetLevelIndex(), NextWaveIndex, GetItemsToSpawn(NextWaveIndex));
+			}
 		}
 	}
 
-	float Duration = 30.0f;
-	if (WaveDurations.IsValidIndex(CurrentWave))
+#if !UE_BUILD_SHIPPING
+	const double SpawnMs = (FPlatformTime::Seconds() - SpawnStartTime) * 1000.0;
+	CH8Debug::RecordWaveSpawnTime(SpawnMs, ItemToSpawn);
+	CH8Metrics::RecordWaveSpawnTime(Rules.GetWaveIndex(), SpawnMs);
+#endif
+
+	Rules.StartWave(WaveCoinCount);
+	SyncFromRules();
+
+	NotifyWaveStarted();
+
+	float Duration = Rules.GetCurrentWaveDuration();
+#if !UE_BUILD_SHIPPING
+	if (CH8Debug::GetWaveDurationOverride() > 0.0f)
 	{
-		Duration = WaveDurations[CurrentWave];
+		Duration = CH8Debug::GetWaveDurationOverride();
 	}
+#endif
 
-	GetWorldTimerManager().SetTimer(
-		WaveTimerHandle,
-		this,
-		&ABaseGameState::OnWaveTimeUp,
-		Duration,
-		false
-	);
+	ScheduleTimer(WaveTimerHandle, Duration, EGameplayTimerKind::WaveDeadline);
+}
+
+int32 ABaseGameState::GetItemsToSpawn(int32 WaveIndex) const
+{
+#if !UE_BUILD_SHIPPING
+	if (CH8Debug::GetItemsPerWaveOverride() > 0)
+	{
+		return CH8Debug::GetItemsPerWaveOverride();
+	}
+#endif
+	return Rules.GetConfig().GetItemsForWave(WaveIndex);
 }
 
 void ABaseGameState::OnWaveTimeUp()
 {
+	Rules.FailWave();
+	NotifyWaveEnded(TEXT("TimeUp"));
+
 	OnGameOver();
 }
 
 void ABaseGameState::ClearAllItems()
 {
-	TArray<AActor*> FoundItems;
-	UGameplayStatics::GetAllActorsOfClass(GetWorld(), ABaseItem::StaticClass(), FoundItems);
+#if !UE_BUILD_SHIPPING
+	const double ClearStartTime = FPlatformTime::Seconds();
+	ON_SCOPE_EXIT
+	{
+		CH8Metrics::RecordWaveClearTime(CurrentWave, (FPlatformTime::Seconds() - ClearStartTime) * 1000.0);
+	};
+#endif
 
-	for (AActor* Item : FoundItems)
+	if (USpawnRecordSubsystem* SpawnRecords = GetWorld()->GetSubsystem<USpawnRecordSubsystem>())
 	{
-		if (Item)
-		{
-			Item->Destroy();
-		}
+		SpawnRecords->Clear();
+	}
+
+	// 액터 반복자는 제거된 액터를 건너뛰므로 반복 중에 바로 제거해도 됨
+	CH8_ALLOC_ALLOW();
+	for (TActorIterator<ABaseItem> It(GetWorld()); It; ++It)
+	{
+		It->Destroy();
 	}
 }
 
 void ABaseGameState::NextLevel()
 {
-	GetWorldTimerManager().ClearTimer(WaveTimerHandle);
-	GetWorldTimerManager().ClearTimer(HUDUpdateTimerHandle);
+	CancelTimer(WaveTimerHandle);
+	CancelTimer(HUDUpdateTimerHandle);
 
 	if (UGameInstance* GameInstance = GetGameInstance())
 	{
@@ -176,10 +238,11 @@ void ABaseGameState::NextLevel()
 		if (BaseGameInstance)
 		{
 			AddScore(Score);
-			CurrentLevelIndex++;
+			const EWaveRulesStep Step = Rules.AdvanceLevel();
+			SyncFromRules();
 			BaseGameInstance->CurrentLevelIndex = CurrentLevelIndex;
 
-			if (CurrentLevelIndex >= MaxLevels)
+			if (Step == EWaveRulesStep::GameCleared)
 			{
 				OnGameOver();
 				return;
@@ -187,6 +250,7 @@ void ABaseGameState::NextLevel()
 
 			if (LevelMapNames.IsValidIndex(CurrentLevelIndex))
 			{
+				UGameplayEventSubsystem::Record(this, EGameplayEventType::LevelChange, CurrentLevelIndex, 0, 0.0f, LevelMapNames[CurrentLevelIndex]);
 				UGameplayStatics::OpenLevel(GetWorld(), LevelMapNames[CurrentLevelIndex]);
 			}
 			else
@@ -199,30 +263,85 @@ void ABaseGameState::NextLevel()
 
 void ABaseGameState::OnCoinCollected()
 {
-	CollectedCoinCount++;
+	OnCoinsCollected(1);
+}
 
-	if (SpawnedCoinCount > 0 && CollectedCoinCount >= SpawnedCoinCount)
+void ABaseGameState::OnCoinsCollected(int32 Count)
+{
+	const EWaveRulesStep Step = Rules.CollectCoins(Count);
+	CollectedCoinCount = Rules.GetCollectedCoins();
+
+	if (Step == EWaveRulesStep::WaveCleared)
 	{
-		GetWorldTimerManager().ClearTimer(WaveTimerHandle);
+		OnWaveCleared();
+	}
+}
 
-		CurrentWave++;
+void ABaseGameState::OnWaveCleared()
+{
+	CancelTimer(WaveTimerHandle);
 
-		if (CurrentWave < MaxWaves)
-		{
-			StartWave();
-		}
-		else
-		{
-			NextLevel();
-		}
+	NotifyWaveEnded(TEXT("Cleared"));
+
+	const EWaveRulesStep NextStep = Rules.AdvanceWave();
+	SyncFromRules();
+
+	if (NextStep == EWaveRulesStep::NextWave)
+	{
+		StartWave();
+	}
+	else
+	{
+		NextLevel();
+	}
+}
+
+void ABaseGameState::OnCoinsExpired(int32 Count)
+{
+	const EWaveRulesStep Step = Rules.ExpireCoins(Count);
+	SpawnedCoinCount = Rules.GetSpawnedCoins();
+
+	// 남은 코인이 모두 사라지고 나머지는 이미 모았으면 웨이브 클리어와 같음
+	if (Step == EWaveRulesStep::WaveCleared)
+	{
+		OnWaveCleared();
 	}
 }
 
 void ABaseGameState::OnGameOver()
 {
-	GetWorldTimerManager().ClearTimer(WaveTimerHandle);
-	GetWorldTimerManager().ClearTimer(HUDUpdateTimerHandle);
-	GetWorldTimerManager().ClearTimer(WaveTextTimerHandle);
+	if (bGameOver)
+	{
+		return;
+	}
+	bGameOver = true;
+
+	// 사망으로 끝나도 웨이브를 닫아야 늦게 도착한 코인 획득이 웨이브/레벨을 넘기지 않음
+	Rules.FailWave();
+	if (URivalCollectorSubsystem* Rivals = GetWorld()->GetSubsystem<URivalCollectorSubsystem>())
+	{
+		Rivals->OnGameOver();
+	}
+
+	CancelTimer(WaveTimerHandle);
+	CancelTimer(HUDUpdateTimerHandle);
+	CancelTimer(WaveTextTimerHandle);
+
+	NotifyWaveEnded(TEXT("GameOver"));
+
+	if (USoakRunSubsystem* SoakRun = UGameInstance::GetSubsystem<USoakRunSubsystem>(GetGameInstance()))
+	{
+		SoakRun->OnGameOver(Rules.IsGameCleared());
+	}
+
+	// 메인 메뉴보다 먼저 기록해야 방금 끝난 판이 순위에 보임 (파일 쓰기는 백그라운드)
+	UBaseGameInstance* BaseGameInstance = Cast<UBaseGameInstance>(GetGameInstance());
+	ULeaderboardSubsystem* Leaderboard = UGameInstance::GetSubsystem<ULeaderboardSubsystem>(GetGameInstance());
+	if (BaseGameInstance && Leaderboard && !BaseGameInstance->bRunRecorded)
+	{
+		BaseGameInstance->bRunRecorded = true;
+		Leaderboard->RecordRun(*BaseGameInstance, Rules.IsGameCleared());
+	}
 
 	if (ACH8_UICharacter* PlayerCharacter = Cast<ACH8_UICharacter>(UGameplayStatics::GetPlayerCharacter(GetWorld(), 0)))
 	{
@@ -246,14 +365,40 @@ void ABaseGameState::HideWaveText()
 
 void ABaseGameState::UpdateHUD()
 {
+	LLM_SCOPE_BYTAG(CH8UI);
+	CH8_ALLOC_SCOPE(HUD);
+#if !UE_BUILD_SHIPPING
+	const double UpdateStartTime = FPlatformTime::Seconds();
+	ON_SCOPE_EXIT
+	{
+		CH8Debug::RecordHUDUpdateTime((FPlatformTime::Seconds() - UpdateStartTime) * 1000.0);
+	};
+#endif
+
 	if (ACH8_UICharacter* PlayerCharacter = Cast<ACH8_UICharacter>(UGameplayStatics::GetPlayerCharacter(GetWorld(), 0)))
 	{
 		if (UUserWidget* HUDWidget = PlayerCharacter->GetHUDWidget())
 		{
+			// 문구는 값이 바뀔 때만 교체. 시간 문구는 레벨 시작 때 만든 표에서 가져옴
 			if (UTextBlock* TimeText = Cast<UTextBlock>(HUDWidget->GetWidgetFromName(TEXT("Time"))))
 			{
-				float RemainingTime = GetWorldTimerManager().GetTimerRemaining(WaveTimerHandle);
-				TimeText->SetText(FText::FromString(FString::Printf(TEXT("Time: %.1f"), RemainingTime)));
+				const UGameplaySchedulerSubsystem* Scheduler = GetWorld()->GetSubsystem<UGameplaySchedulerSubsystem>();
+				const float RemainingTime = Scheduler ? Scheduler->GetRemaining(WaveTimerHandle) : 0.0f;
+				const int32 Tenths = FMath::Max(FMath::RoundToInt(RemainingTime * 10.0f), 0);
+				if (Tenths != ShownTimeTenths)
+				{
+					ShownTimeTenths = Tenths;
+					if (TimeTexts.IsValidIndex(Tenths))
+					{
+						TimeText->SetText(TimeTexts[Tenths]);
+					}
+					else
+					{
+						// ch8.WaveDuration 등으로 표보다 긴 웨이브
+						CH8_ALLOC_ALLOW();
+						TimeText->SetText(FText::FromString(FString::Printf(TEXT("Time: %.1f"), RemainingTime)));
+					}
+				}
 			}
 
 			if (UTextBlock* ScoreText = Cast<UTextBlock>(HUDWidget->GetWidgetFromName(TEXT("Score"))))
@@ -261,17 +406,214 @@ void ABaseGameState::UpdateHUD()
 				if (UGameInstance* GameInstance = GetGameInstance())
 				{
 					UBaseGameInstance* BaseGameInstance = Cast<UBaseGameInstance>(GameInstance);
-					if (BaseGameInstance)
+					if (BaseGameInstance && BaseGameInstance->TotalScore != ShownScore)
 					{
-						ScoreText->SetText(FText::FromString(FString::Printf(TEXT("Score: %d"), BaseGameInstance->TotalScore)));
+						// 점수는 범위가 정해져 있지 않아 표를 만들 수 없음. 바뀔 때 한 번만 만드는 문구는 검사에서 제외
+						CH8_ALLOC_ALLOW();
+						ShownScore = BaseGameInstance->TotalScore;
+						TStringBuilder<32> Builder;
+						Builder.Appendf(TEXT("Score: %d"), ShownScore);
+						ScoreText->SetText(FText::FromStringView(Builder.ToView()));
 					}
 				}
 			}
 
 			if (UTextBlock* LevelIndexText = Cast<UTextBlock>(HUDWidget->GetWidgetFromName(TEXT("Level"))))
 			{
-				LevelIndexText->SetText(FText::FromString(FString::Printf(TEXT("Level: %d"), CurrentLevelIndex + 1)));
+				if (!LevelIndexText->GetText().IdenticalTo(LevelText))
+				{
+					LevelIndexText->SetText(LevelText);
+				}
 			}
 		}
 	}
 }
+
+void ABaseGameState::BuildHUDTexts()
+{
+	LLM_SCOPE_BYTAG(CH8UI);
+
+	// 0.1초 단위로 가장 긴 웨이브 시간까지의 시간 문구
+	float MaxDuration = 0.0f;
+	for (int32 WaveIndex = 0; WaveIndex < Rules.GetConfig().MaxWaves; WaveIndex++)
+	{
+		MaxDuration = FMath::Max(MaxDuration, Rules.GetConfig().GetWaveDuration(WaveIndex));
+	}
+
+	const int32 NumTimeTexts = FMath::CeilToInt(MaxDuration * 10.0f) + 1;
+	if (TimeTexts.Num() != NumTimeTexts)
+	{
+		TimeTexts.Reset(NumTimeTexts);
+		for (int32 Tenths = 0; Tenths < NumTimeTexts; Tenths++)
+		{
+			TimeTexts.Add(FText::FromString(FString::Printf(TEXT("Time: %.1f"), Tenths / 10.0f)));
+		}
+	}
+
+	LevelText = FText::FromString(FString::Printf(TEXT("Level: %d"), CurrentLevelIndex + 1));
+	ShownTimeTenths = INDEX_NONE;
+	ShownScore = INDEX_NONE;
+}
+
+void ABaseGameState::ScheduleTimer(FGameplayTimerHandle& Handle, float Delay, EGameplayTimerKind Kind)
+{
+	if (UGameplaySchedulerSubsystem* Scheduler = GetWorld()->GetSubsystem<UGameplaySchedulerSubsystem>())
+	{
+		Scheduler->Cancel(Handle);
+		Handle = Scheduler->Schedule(Delay, Kind, this);
+	}
+}
+
+void ABaseGameState::CancelTimer(FGameplayTimerHandle& Handle)
+{
+	if (UGameplaySchedulerSubsystem* Scheduler = GetWorld()->GetSubsystem<UGameplaySchedulerSubsystem>())
+	{
+		Scheduler->Cancel(Handle);
+	}
+	Handle.Invalidate();
+}
+
+void ABaseGameState::RegisterTimerHandlers()
+{
+	UGameplaySchedulerSubsystem* Scheduler = GetWorld()->GetSubsystem<UGameplaySchedulerSubsystem>();
+	if (!Scheduler)
+	{
+		return;
+	}
+
+	Scheduler->SetHandler(EGameplayTimerKind::WaveDeadline, [](TConstArrayView<FGameplayTimerEvent> Events)
+	{
+		for (const FGameplayTimerEvent& Event : Events)
+		{
+			if (ABaseGameState* GameState = Cast<ABaseGameState>(Event.Target.Get()))
+			{
+				GameState->WaveTimerHandle.Invalidate();
+				GameState->OnWaveTimeUp();
+			}
+		}
+	});
+	Scheduler->SetHandler(EGameplayTimerKind::WaveText, [](TConstArrayView<FGameplayTimerEvent> Events)
+	{
+		for (const FGameplayTimerEvent& Event : Events)
+		{
+			if (ABaseGameState* GameState = Cast<ABaseGameState>(Event.Target.Get()))
+			{
+				GameState->WaveTextTimerHandle.Invalidate();
+				GameState->HideWaveText();
+			}
+		}
+	});
+	Scheduler->SetHandler(EGameplayTimerKind::HUDRefresh, [](TConstArrayView<FGameplayTimerEvent> Events)
+	{
+		for (const FGameplayTimerEvent& Event : Events)
+		{
+			if (ABaseGameState* GameState = Cast<ABaseGameState>(Event.Target.Get()))
+			{
+				GameState->UpdateHUD();
+				GameState->ScheduleTimer(GameState->HUDUpdateTimerHandle, 0.1f, EGameplayTimerKind::HUDRefresh);
+			}
+		}
+	});
+}
+
+void ABaseGameState::NotifyWaveStarted()
+{
+	bWaveInProgress = true;
+
+	UGameplayEventSubsystem::Record(this, EGameplayEventType::WaveStart, CurrentLevelIndex, CurrentWave, SpawnedCoinCount);
+#if !UE_BUILD_SHIPPING
+	CH8Metrics::SetLevelAndWave(CurrentLevelIndex, CurrentWave);
+#endif
+
+	if (UWaveTelemetrySubsystem* Telemetry = GetWorld()->GetSubsystem<UWaveTelemetrySubsystem>())
+	{
+		Telemetry->BeginWave(CurrentLevelIndex, CurrentWave);
+	}
+
+	if (USoakRunSubsystem* SoakRun = UGameInstance::GetSubsystem<USoakRunSubsystem>(GetGameInstance()))
+	{
+		SoakRun->OnWaveStarted(CurrentLevelIndex, CurrentWave);
+	}
+}
+
+void ABaseGameState::NotifyWaveEnded(const TCHAR* Outcome)
+{
+	if (!bWaveInProgress)
+	{
+		return;
+	}
+	bWaveInProgress = false;
+
+#if !UE_BUILD_SHIPPING
+	CH8AllocCheck::OnWaveEnded(CurrentWave);
+#endif
+
+	UGameplayEventSubsystem::Record(this, EGameplayEventType::WaveEnd, CurrentLevelIndex, CurrentWave, 0.0f, FName(Outcome));
+
+	if (UWaveTelemetrySubsystem* Telemetry = GetWorld()->GetSubsystem<UWaveTelemetrySubsystem>())
+	{
+		Telemetry->EndWave(Outcome);
+	}
+
+	if (USoakRunSubsystem* SoakRun = UGameInstance::GetSubsystem<USoakRunSubsystem>(GetGameInstance()))
+	{
+		SoakRun->OnWaveEnded(Outcome);
+	}
+}
+
+FWaveRulesConfig ABaseGameState::MakeRulesConfig() const
+{
+	FWaveRulesConfig Config;
+	Config.MaxLevels = MaxLevels;
+	Config.MaxWaves = MaxWaves;
+	Config.WaveDurations = WaveDurations;
+	Config.ItemsPerWave = ItemsPerWave;
+	return Config;
+}
+
+void ABaseGameState::SyncFromRules()
+{
+	CurrentLevelIndex = Rules.GetLevelIndex();
+	CurrentWave = Rules.GetWaveIndex();
+	SpawnedCoinCount = Rules.GetSpawnedCoins();
+	CollectedCoinCount = Rules.GetCollectedCoins();
+}
+
+#if !UE_BUILD_SHIPPING
+void ABaseGameState::DebugSkipToWave(int32 WaveIndex)
+{
+	WaveIndex = FMath::Clamp(WaveIndex, 0, FMath::Max(MaxWaves - 1, 0));
+
+	CancelTimer(WaveTimerHandle);
+	NotifyWaveEnded(TEXT("Skipped"));
+
+	Rules.StartLevel(CurrentLevelIndex);
+	for (int32 Index = 0; Index < WaveIndex; Index++)
+	{
+		Rules.AdvanceWave();
+	}
+	SyncFromRules();
+	StartWave();
+}
+
+void ABaseGameState::DebugSkipToLevel(int32 LevelIndex)
+{
+	if (!LevelMapNames.IsValidIndex(LevelIndex))
+	{
+		UE_LOG(LogTemp, Warning, TEXT("DebugSkipToLevel: no map for level %d"), LevelIndex + 1);
+		return;
+	}
+
+	CancelTimer(WaveTimerHandle);
+	CancelTimer(HUDUpdateTimerHandle);
+	NotifyWaveEnded(TEXT("Skipped"));
+
+	if (UBaseGameInstance* BaseGameInstance = Cast<UBaseGameInstance>(GetGameInstance()))
+	{
+		BaseGameInstance->CurrentLevelIndex = LevelIndex;
+	}
+
+	UGameplayEventSubsystem::Record(this, EGameplayEventType::LevelChange, LevelIndex, 0, 0.0f, LevelMapNames[LevelIndex]);
+	UGameplayStatics::OpenLevel(GetWorld(), LevelMapNames[LevelIndex]);
+}
+#endif
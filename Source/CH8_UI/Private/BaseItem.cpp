@@ -2,6 +2,16 @@
 
 
 #include "BaseItem.h"
+#include "GameplayEventSubsystem.h"
+#include "ItemEffectSubsystem.h"
+#include "ItemSpawnRow.h"
+#include "GameplaySchedulerSubsystem.h"
+#include "SpawnGovernorSubsystem.h"
+#include "SpawnRecordSubsystem.h"
+#include "GameplayDebug.h"
+#include "GameplayMetrics.h"
+#include "GameplayAllocCheck.h"
+#include "RivalCollectorsActor.h"
 #include "Components/SphereComponent.h"
 
 ABaseItem::ABaseItem()
@@ -29,6 +39,51 @@ ABaseItem::ABaseItem()
 	Collision->OnComponentEndOverlap.AddDynamic(this, &ABaseItem::OnItemEndOverlap);
 }
 
+void ABaseItem::BeginPlay()
+{
+	Super::BeginPlay();
+
+	if (UItemEffectSubsystem* EffectSubsystem = GetWorld()->GetSubsystem<UItemEffectSubsystem>())
+	{
+		ItemTypeId = EffectSubsystem->RegisterItemType(ItemType, *this);
+	}
+#if !UE_BUILD_SHIPPING
+	CH8Metrics::AddLiveItem(ItemTypeId, ItemType, 1);
+#endif
+
+	if (USpawnGovernorSubsystem* SpawnGovernor = GetWorld()->GetSubsystem<USpawnGovernorSubsystem>())
+	{
+		SpawnGovernor->NotifyItemSpawned();
+	}
+}
+
+void ABaseItem::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	if (UItemEffectSubsystem* EffectSubsystem = GetWorld()->GetSubsystem<UItemEffectSubsystem>())
+	{
+		EffectSubsystem->CancelEffect(EffectTimerHandle);
+		EffectSubsystem->CancelExpiry(ExpiryTimerHandle);
+	}
+
+	if (SpawnRecordIndex != INDEX_NONE)
+	{
+		if (USpawnRecordSubsystem* SpawnRecords = GetWorld()->GetSubsystem<USpawnRecordSubsystem>())
+		{
+			SpawnRecords->OnItemEndPlay(this, SpawnRecordIndex, SpawnRecordSerial);
+		}
+	}
+
+	if (USpawnGovernorSubsystem* SpawnGovernor = GetWorld()->GetSubsystem<USpawnGovernorSubsystem>())
+	{
+		SpawnGovernor->NotifyItemRemoved();
+	}
+#if !UE_BUILD_SHIPPING
+	CH8Metrics::AddLiveItem(ItemTypeId, ItemType, -1);
+#endif
+
+	Super::EndPlay(EndPlayReason);
+}
+
 void ABaseItem::OnItemOverlap(
 			UPrimitiveComponent* OverlappedComp,
 			AActor* OtherActor, 
@@ -37,6 +92,10 @@ void ABaseItem::OnItemOverlap(
 			bool bFromSweep, 
 			const FHitResult& SweepResult)
 {
+#if !UE_BUILD_SHIPPING
+	CH8Debug::RecordOverlap();
+#endif
+
 	// OtherActor가 플레이어인지 확인 ("Player" 태그 활용)
 	if (OtherActor && OtherActor->ActorHasTag("Player"))
 	{
@@ -54,8 +113,73 @@ void ABaseItem::OnItemEndOverlap(
 }
 
 // 아이템이 사용(Activate)되었을 때 동작
+// 효과는 바로 적용하지 않고 UItemEffectSubsystem 큐에 넣어 프레임 단위로 일괄 처리
 void ABaseItem::ActivateItem(AActor* Activator)
 {
+	// 플레이어와 라이벌 수집기(URivalCollectorSubsystem)만 획득 가능
+	if (!Activator || !(Activator->ActorHasTag("Player") || Activator->ActorHasTag(ARivalCollectorsActor::RivalTag)) || bEffectPending)
+	{
+		return;
+	}
+
+	CH8_ALLOC_SCOPE(Pickup);
+
+	UItemEffectSubsystem* EffectSubsystem = GetWorld()->GetSubsystem<UItemEffectSubsystem>();
+	FItemEffectRow Effect;
+	if (!EffectSubsystem || !EffectSubsystem->ResolveEffect(*this, Effect))
+	{
+		return;
+	}
+
+	UGameplayEventSubsystem::Record(this, EGameplayEventType::Pickup, FMath::RoundToInt(Effect.Magnitude), 0, 0.0f, ItemType);
+#if !UE_BUILD_SHIPPING
+	CH8Metrics::RecordPickup();
+#endif
+	EffectTimerHandle = EffectSubsystem->QueueEffect(ItemTypeId, EffectOverrides, Activator, this);
+	// 획득된 아이템은 더 이상 수명 만료 대상이 아님
+	EffectSubsystem->CancelExpiry(ExpiryTimerHandle);
+
+	if (Effect.bDestroyOnActivate)
+	{
+		DestroyItem();
+	}
+	else
+	{
+		bEffectPending = true;
+	}
+}
+
+void ABaseItem::ApplySpawnRow(const FItemSpawnRow& SpawnRow)
+{
+	// 종류 공통 정의는 건드리지 않고 이 아이템에만 적용
+	EffectOverrides.Radius = SpawnRow.EffectRadius;
+	EffectOverrides.Duration = SpawnRow.EffectDuration;
+	EffectOverrides.Magnitude = SpawnRow.EffectMagnitude;
+
+	if (UItemEffectSubsystem* EffectSubsystem = GetWorld()->GetSubsystem<UItemEffectSubsystem>())
+	{
+		ExpiryTimerHandle = EffectSubsystem->ScheduleExpiry(this, SpawnRow.Lifetime);
+	}
+}
+
+float ABaseItem::GetRemainingLifetime() const
+{
+	const UGameplaySchedulerSubsystem* Scheduler = GetWorld()->GetSubsystem<UGameplaySchedulerSubsystem>();
+	return Scheduler ? Scheduler->GetRemaining(ExpiryTimerHandle) : 0.0f;
+}
+
+void ABaseItem::SetRemainingLifetime(float Lifetime)
+{
+	if (UItemEffectSubsystem* EffectSubsystem = GetWorld()->GetSubsystem<UItemEffectSubsystem>())
+	{
+		EffectSubsystem->CancelExpiry(ExpiryTimerHandle);
+		ExpiryTimerHandle = EffectSubsystem->ScheduleExpiry(this, Lifetime);
+	}
+}
+
+void ABaseItem::DescribeEffect(FItemEffectRow& OutEffect) const
+{
+	OutEffect.EffectType = EItemEffectType::None;
 }
 
 // 아이템 유형을 반환
@@ -67,6 +191,8 @@ FName ABaseItem::GetItemType() const
 // 아이템을 파괴(제거)하는 함수
 void ABaseItem::DestroyItem()
 {
+	// 액터 제거 자체의 할당은 할당 검사에서 제외
+	CH8_ALLOC_ALLOW();
 	// AActor에서 제공하는 Destroy() 함수로 객체 제거
 	Destroy();
 }
\ No newline at end of file
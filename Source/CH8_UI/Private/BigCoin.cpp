@@ -8,8 +8,3 @@ ABigCoin::ABigCoin()
 	PointValue = 50;
 	ItemType = "BigCoin";
 }
-
-void ABigCoin::ActivateItem(AActor* Activator)
-{
-	Super::ActivateItem(Activator);
-}
\ No newline at end of file
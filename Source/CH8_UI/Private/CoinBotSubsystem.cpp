@@ -0,0 +1,157 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "CoinBotSubsystem.h"
+#include "CoinItem.h"
+#include "MineItem.h"
+#include "SoakRunSubsystem.h"
+#include "CH8_UI/CH8_UICharacter.h"
+#include "EngineUtils.h"
+#include "Kismet/GameplayStatics.h"
+#include "Misc/CommandLine.h"
+
+bool UCoinBotSubsystem::ShouldCreateSubsystem(UObject* Outer) const
+{
+	const UWorld* World = Cast<UWorld>(Outer);
+	if (!World || !World->IsGameWorld())
+	{
+		return false;
+	}
+	return FParse::Param(FCommandLine::Get(), TEXT("CoinBot")) || USoakRunSubsystem::IsSoakRequested();
+}
+
+TStatId UCoinBotSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UCoinBotSubsystem, STATGROUP_Tickables);
+}
+
+void UCoinBotSubsystem::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	UWorld* World = GetWorld();
+	ACH8_UICharacter* PlayerCharacter = Cast<ACH8_UICharacter>(UGameplayStatics::GetPlayerCharacter(World, 0));
+	if (!PlayerCharacter || World->GetMapName().Contains("MenuLevel"))
+	{
+		return;
+	}
+
+	const FVector BotLocation = PlayerCharacter->GetActorLocation();
+	const double Now = World->GetTimeSeconds();
+
+	if (!TargetCoin.IsValid() || Now >= NextRetargetTime)
+	{
+		NextRetargetTime = Now + RetargetInterval;
+		SelectTarget(BotLocation);
+	}
+
+	AActor* Target = TargetCoin.Get();
+	if (!Target)
+	{
+		return;
+	}
+
+	const FVector TargetLocation = Target->GetActorLocation();
+	const float Distance2D = FVector::Dist2D(BotLocation, TargetLocation);
+
+	// 진행이 멈췄으면 (벽, 높은 곳 등) 잠시 다른 코인을 노림
+	if (Distance2D < BestTargetDistance - 50.0f)
+	{
+		BestTargetDistance = Distance2D;
+		LastProgressTime = Now;
+	}
+	else if (Now - LastProgressTime > StuckTimeout)
+	{
+		IgnoredCoinsUntil.Add(TargetCoin, Now + GiveUpDuration);
+		TargetCoin.Reset();
+		return;
+	}
+
+	FVector MoveDirection = (TargetLocation - BotLocation).GetSafeNormal2D();
+
+	// 가까운 지뢰에서 멀어지는 방향을 섞어서 우회
+	for (const FVector& MineLocation : MineLocations)
+	{
+		const float MineDistance = FVector::Dist2D(BotLocation, MineLocation);
+		if (MineDistance < MineAvoidRadius)
+		{
+			const float Weight = 1.0f - MineDistance / MineAvoidRadius;
+			MoveDirection += (BotLocation - MineLocation).GetSafeNormal2D() * Weight * 2.0f;
+		}
+	}
+
+	PlayerCharacter->AddMovementInput(MoveDirection.GetSafeNormal2D(), 1.0f);
+
+	// 공중에 스폰된 코인은 점프로 획득
+	if (Distance2D < 250.0f && TargetLocation.Z - BotLocation.Z > 120.0f)
+	{
+		PlayerCharacter->Jump();
+	}
+}
+
+void UCoinBotSubsystem::SelectTarget(const FVector& BotLocation)
+{
+	UWorld* World = GetWorld();
+	const double Now = World->GetTimeSeconds();
+
+	MineLocations.Reset();
+	for (TActorIterator<AMineItem> It(World); It; ++It)
+	{
+		if (IsValid(*It))
+		{
+			MineLocations.Add(It->GetActorLocation());
+		}
+	}
+
+	for (auto It = IgnoredCoinsUntil.CreateIterator(); It; ++It)
+	{
+		if (!It.Key().IsValid() || It.Value() <= Now)
+		{
+			It.RemoveCurrent();
+		}
+	}
+
+	AActor* BestCoin = nullptr;
+	float BestScore = TNumericLimits<float>::Max();
+	for (TActorIterator<ACoinItem> It(World); It; ++It)
+	{
+		ACoinItem* Coin = *It;
+		if (!IsValid(Coin) || IgnoredCoinsUntil.Contains(Coin))
+		{
+			continue;
+		}
+
+		const FVector CoinLocation = Coin->GetActorLocation();
+		float Score = FVector::Dist(BotLocation, CoinLocation);
+		if (IsNearMine(CoinLocation, MineAvoidRadius))
+		{
+			Score += MinePenaltyDistance;
+		}
+
+		if (Score < BestScore)
+		{
+			BestScore = Score;
+			BestCoin = Coin;
+		}
+	}
+
+	if (BestCoin != TargetCoin.Get())
+	{
+		TargetCoin = BestCoin;
+		BestTargetDistance = TNumericLimits<float>::Max();
+		LastProgressTime = Now;
+	}
+}
+
+bool UCoinBotSubsystem::IsNearMine(const FVector& Location, float Radius) const
+{
+	const float RadiusSquared = FMath::Square(Radius);
+	for (const FVector& MineLocation : MineLocations)
+	{
+		if (FVector::DistSquared(Location, MineLocation) < RadiusSquared)
+		{
+			return true;
+		}
+	}
+	return false;
+}
@@ -2,7 +2,7 @@
 
 
 #include "CoinItem.h"
-#include "BaseGameState.h"
+#include "CoinSpatialIndexSubsystem.h"
 
 ACoinItem::ACoinItem()
 {
@@ -10,19 +10,30 @@ ACoinItem::ACoinItem()
 	ItemType = "DefaultCoin";
 }
 
-void ACoinItem::ActivateItem(AActor* Activator)
+void ACoinItem::BeginPlay()
 {
-	if (Activator && Activator->ActorHasTag("Player"))
+	Super::BeginPlay();
+
+	if (UCoinSpatialIndexSubsystem* SpatialIndex = GetWorld()->GetSubsystem<UCoinSpatialIndexSubsystem>())
+	{
+		SpatialIndex->RegisterCoin(this);
+	}
+}
+
+void ACoinItem::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	if (UCoinSpatialIndexSubsystem* SpatialIndex = GetWorld()->GetSubsystem<UCoinSpatialIndexSubsystem>())
 	{
-		if (UWorld* World = GetWorld())
-		{
-			if (ABaseGameState* GameState = World->GetGameState<ABaseGameState>())
-			{
-				GameState->AddScore(PointValue);
-				GameState->OnCoinCollected();
-			}
-		}
-		
-		DestroyItem();
+		SpatialIndex->UnregisterCoin(this);
 	}
+
+	Super::EndPlay(EndPlayReason);
+}
+
+void ACoinItem::DescribeEffect(FItemEffectRow& OutEffect) const
+{
+	// 코인 획득 시 점수를 주고 웨이브 완료 조건에 포함
+	OutEffect.EffectType = EItemEffectType::Score;
+	OutEffect.Magnitude = PointValue;
+	OutEffect.bCountsAsCoin = true;
 }
\ No newline at end of file
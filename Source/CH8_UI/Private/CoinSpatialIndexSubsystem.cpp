@@ -0,0 +1,233 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "CoinSpatialIndexSubsystem.h"
+#include "CoinItem.h"
+#include "Engine/World.h"
+
+bool UCoinSpatialIndexSubsystem::ShouldCreateSubsystem(UObject* Outer) const
+{
+	const UWorld* World = Cast<UWorld>(Outer);
+	return World && World->IsGameWorld();
+}
+
+TStatId UCoinSpatialIndexSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UCoinSpatialIndexSubsystem, STATGROUP_Tickables);
+}
+
+FIntPoint UCoinSpatialIndexSubsystem::GetCellCoord(const FVector& Location) const
+{
+	return FIntPoint(FMath::FloorToInt(Location.X / CellSize), FMath::FloorToInt(Location.Y / CellSize));
+}
+
+void UCoinSpatialIndexSubsystem::RegisterCoin(ACoinItem* Coin)
+{
+	if (!Coin || CoinCells.Contains(Coin))
+	{
+		return;
+	}
+
+	const FIntPoint Cell = GetCellCoord(Coin->GetActorLocation());
+	Cells.FindOrAdd(Cell).Add(Coin);
+	CoinCells.Add(Coin, Cell);
+}
+
+void UCoinSpatialIndexSubsystem::UnregisterCoin(ACoinItem* Coin)
+{
+	FIntPoint Cell;
+	if (!CoinCells.RemoveAndCopyValue(Coin, Cell))
+	{
+		return;
+	}
+
+	if (auto* CellCoins = Cells.Find(Cell))
+	{
+		CellCoins->RemoveSwap(Coin);
+		if (CellCoins->IsEmpty())
+		{
+			Cells.Remove(Cell);
+		}
+	}
+}
+
+void UCoinSpatialIndexSubsystem::UpdateCoinLocation(ACoinItem* Coin, const FVector& NewLocation)
+{
+	FIntPoint* OldCell = CoinCells.Find(Coin);
+	if (!OldCell)
+	{
+		return;
+	}
+
+	const FIntPoint NewCell = GetCellCoord(NewLocation);
+	if (NewCell == *OldCell)
+	{
+		return;
+	}
+
+	if (auto* CellCoins = Cells.Find(*OldCell))
+	{
+		CellCoins->RemoveSwap(Coin);
+		if (CellCoins->IsEmpty())
+		{
+			Cells.Remove(*OldCell);
+		}
+	}
+
+	Cells.FindOrAdd(NewCell).Add(Coin);
+	*OldCell = NewCell;
+}
+
+void UCoinSpatialIndexSubsystem::QueryCoinsInRadius(const FVector& Center, float Radius, TArray<ACoinItem*>& OutCoins) const
+{
+	const FIntPoint MinCell = GetCellCoord(Center - FVector(Radius));
+	const FIntPoint MaxCell = GetCellCoord(Center + FVector(Radius));
+	const float RadiusSquared = FMath::Square(Radius);
+
+	for (int32 CellY = MinCell.Y; CellY <= MaxCell.Y; CellY++)
+	{
+		for (int32 CellX = MinCell.X; CellX <= MaxCell.X; CellX++)
+		{
+			const auto* CellCoins = Cells.Find(FIntPoint(CellX, CellY));
+			if (!CellCoins)
+			{
+				continue;
+			}
+
+			for (ACoinItem* Coin : *CellCoins)
+			{
+				if (FVector::DistSquared(Center, Coin->GetActorLocation()) <= RadiusSquared)
+				{
+					OutCoins.Add(Coin);
+				}
+			}
+		}
+	}
+}
+
+void UCoinSpatialIndexSubsystem::StartAttraction(AActor* Target, float Radius, float Duration, float PullSpeed)
+{
+	if (!Target || Radius <= 0.0f || Duration <= 0.0f)
+	{
+		return;
+	}
+
+	FMagnetAttractor& Attractor = Attractors.AddDefaulted_GetRef();
+	Attractor.Target = Target;
+	Attractor.EndTime = GetWorld()->GetTimeSeconds() + Duration;
+	Attractor.Radius = Radius;
+	Attractor.PullSpeed = PullSpeed;
+}
+
+void UCoinSpatialIndexSubsystem::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	if (Attractors.Num() > 0)
+	{
+		UpdateAttraction(DeltaTime);
+	}
+}
+
+void UCoinSpatialIndexSubsystem::UpdateAttraction(float DeltaTime)
+{
+	const double Now = GetWorld()->GetTimeSeconds();
+	Attractors.RemoveAllSwap([Now](const FMagnetAttractor& Attractor)
+	{
+		return !Attractor.Target.IsValid() || Attractor.EndTime <= Now;
+	});
+
+	// 1) 자석 반경 안의 코인 수집
+	AttractedCoins.Reset();
+	AttractedTargets.Reset();
+	AttractedSet.Reset();
+	for (const FMagnetAttractor& Attractor : Attractors)
+	{
+		AActor* Target = Attractor.Target.Get();
+		QueryResult.Reset();
+		QueryCoinsInRadius(Target->GetActorLocation(), Attractor.Radius, QueryResult);
+
+		for (ACoinItem* Coin : QueryResult)
+		{
+			bool bAlreadyAttracted = false;
+			AttractedSet.Add(Coin, &bAlreadyAttracted);
+			if (!bAlreadyAttracted)
+			{
+				AttractedCoins.Add(Coin);
+				AttractedTargets.Add(Target);
+				MaxStep.Add(Attractor.PullSpeed * DeltaTime);
+			}
+		}
+	}
+
+	const int32 NumCoins = AttractedCoins.Num();
+	if (NumCoins == 0)
+	{
+		MaxStep.Reset();
+		return;
+	}
+
+	PosX.SetNumUninitialized(NumCoins, EAllowShrinking::No);
+	PosY.SetNumUninitialized(NumCoins, EAllowShrinking::No);
+	PosZ.SetNumUninitialized(NumCoins, EAllowShrinking::No);
+	GoalX.SetNumUninitialized(NumCoins, EAllowShrinking::No);
+	GoalY.SetNumUninitialized(NumCoins, EAllowShrinking::No);
+	GoalZ.SetNumUninitialized(NumCoins, EAllowShrinking::No);
+	Arrived.SetNumUninitialized(NumCoins, EAllowShrinking::No);
+
+	for (int32 Index = 0; Index < NumCoins; Index++)
+	{
+		const FVector Position = AttractedCoins[Index]->GetActorLocation();
+		const FVector Goal = AttractedTargets[Index]->GetActorLocation();
+		PosX[Index] = Position.X;
+		PosY[Index] = Position.Y;
+		PosZ[Index] = Position.Z;
+		GoalX[Index] = Goal.X;
+		GoalY[Index] = Goal.Y;
+		GoalZ[Index] = Goal.Z;
+	}
+
+	// 2) 모든 코인의 다음 위치를 한 번에 계산 (연속 배열 위의 분기 없는 루프)
+	const float ArriveDistanceSquared = FMath::Square(ArriveDistance);
+	for (int32 Index = 0; Index < NumCoins; Index++)
+	{
+		const float DeltaX = GoalX[Index] - PosX[Index];
+		const float DeltaY = GoalY[Index] - PosY[Index];
+		const float DeltaZ = GoalZ[Index] - PosZ[Index];
+		const float DistanceSquared = DeltaX * DeltaX + DeltaY * DeltaY + DeltaZ * DeltaZ;
+		const float Distance = FMath::Sqrt(DistanceSquared);
+		const float Alpha = FMath::Min(MaxStep[Index] / FMath::Max(Distance, UE_KINDA_SMALL_NUMBER), 1.0f);
+
+		PosX[Index] += DeltaX * Alpha;
+		PosY[Index] += DeltaY * Alpha;
+		PosZ[Index] += DeltaZ * Alpha;
+		Arrived[Index] = DistanceSquared * FMath::Square(1.0f - Alpha) <= ArriveDistanceSquared;
+	}
+
+	// 3) 결과 반영. 이동 중 겹침으로 이미 획득된 코인은 건너뜀
+	for (int32 Index = 0; Index < NumCoins; Index++)
+	{
+		ACoinItem* Coin = AttractedCoins[Index];
+		if (!IsValid(Coin))
+		{
+			continue;
+		}
+
+		const FVector NewLocation(PosX[Index], PosY[Index], PosZ[Index]);
+		Coin->SetActorLocation(NewLocation);
+		if (!IsValid(Coin))
+		{
+			continue;
+		}
+
+		UpdateCoinLocation(Coin, NewLocation);
+
+		if (Arrived[Index])
+		{
+			IItemInterface* Item = Coin;
+			Item->ActivateItem(AttractedTargets[Index]);
+		}
+	}
+
+	MaxStep.Reset();
+}
@@ -0,0 +1,227 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "FloatingTextSubsystem.h"
+#include "SFloatingTextLayer.h"
+#include "GameplayLLMTags.h"
+#include "Engine/GameViewportClient.h"
+#include "Engine/World.h"
+#include "Framework/Application/SlateApplication.h"
+#include "Fonts/FontMeasure.h"
+#include "GameFramework/PlayerController.h"
+#include "Styling/CoreStyle.h"
+
+DECLARE_STATS_GROUP(TEXT("CH8 UI"), STATGROUP_CH8UI, STATCAT_Advanced);
+DECLARE_CYCLE_STAT(TEXT("Floating Text Update"), STAT_FloatingTextUpdate, STATGROUP_CH8UI);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Floating Text Pool Size"), STAT_FloatingTextPoolSize, STATGROUP_CH8UI);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Floating Text Active"), STAT_FloatingTextActive, STATGROUP_CH8UI);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Floating Text Drawn"), STAT_FloatingTextDrawn, STATGROUP_CH8UI);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Floating Text Overwritten (Pool Full)"), STAT_FloatingTextOverwritten, STATGROUP_CH8UI);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Floating Text Cached Strings"), STAT_FloatingTextCachedStrings, STATGROUP_CH8UI);
+
+bool UFloatingTextSubsystem::ShouldCreateSubsystem(UObject* Outer) const
+{
+	const UWorld* World = Cast<UWorld>(Outer);
+	return World && World->IsGameWorld() && !IsRunningDedicatedServer();
+}
+
+void UFloatingTextSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	LLM_SCOPE_BYTAG(CH8UI);
+	Entries.SetNum(FMath::Max(PoolSize, 1));
+	DrawItems.Reserve(Entries.Num());
+	TextCache.Reserve(MaxCachedTexts);
+
+	Font = FCoreStyle::GetDefaultFontStyle("Bold", FontSize);
+	Font.OutlineSettings.OutlineSize = 2;
+}
+
+void UFloatingTextSubsystem::OnWorldBeginPlay(UWorld& InWorld)
+{
+	Super::OnWorldBeginPlay(InWorld);
+
+	UGameViewportClient* GameViewport = InWorld.GetGameViewport();
+	if (!GameViewport)
+	{
+		return;
+	}
+
+	LLM_SCOPE_BYTAG(CH8UI);
+	Layer = SNew(SFloatingTextLayer).Subsystem(this);
+	// 메뉴/HUD 위젯(UMG 기본 ZOrder 0)보다 아래에 그려서 메뉴를 가리지 않도록 함
+	GameViewport->AddViewportWidgetContent(Layer.ToSharedRef(), -1);
+}
+
+void UFloatingTextSubsystem::Deinitialize()
+{
+	if (Layer.IsValid())
+	{
+		if (UGameViewportClient* GameViewport = GetWorld()->GetGameViewport())
+		{
+			GameViewport->RemoveViewportWidgetContent(Layer.ToSharedRef());
+		}
+		Layer.Reset();
+	}
+
+	DrawItems.Reset();
+	TextCache.Reset();
+	EvictionCandidates.Reset();
+	Super::Deinitialize();
+}
+
+TStatId UFloatingTextSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UFloatingTextSubsystem, STATGROUP_Tickables);
+}
+
+UFloatingTextSubsystem::FCachedText& UFloatingTextSubsystem::FindOrAddText(EFloatingTextKind Kind, int32 Value)
+{
+	// 값 전체를 키에 넣어 큰 점수/데미지도 서로 다른 문구로 캐시됨
+	const uint64 Key = (static_cast<uint64>(Kind) << 32) | static_cast<uint32>(Value);
+	if (const TUniquePtr<FCachedText>* Cached = TextCache.Find(Key))
+	{
+		(*Cached)->LastUsedFrame = GFrameCounter;
+		return **Cached;
+	}
+
+	if (TextCache.Num() >= MaxCachedTexts)
+	{
+		EvictTexts();
+	}
+
+	LLM_SCOPE_BYTAG(CH8UI);
+	TUniquePtr<FCachedText> NewText = MakeUnique<FCachedText>();
+	NewText->LastUsedFrame = GFrameCounter;
+	NewText->Text = FText::FromString(FString::Printf(Kind == EFloatingTextKind::Score ? TEXT("+%d") : TEXT("-%d"), Value));
+	if (FSlateApplication::IsInitialized())
+	{
+		const FVector2D Size = FSlateApplication::Get().GetRenderer()->GetFontMeasureService()->Measure(NewText->Text, Font);
+		NewText->HalfSize = FVector2f(Size * 0.5);
+	}
+
+	FCachedText& Result = *NewText;
+	TextCache.Add(Key, MoveTemp(NewText));
+	SET_DWORD_STAT(STAT_FloatingTextCachedStrings, TextCache.Num());
+	return Result;
+}
+
+void UFloatingTextSubsystem::EvictTexts()
+{
+	EvictionCandidates.Reset();
+	for (const TPair<uint64, TUniquePtr<FCachedText>>& Pair : TextCache)
+	{
+		if (Pair.Value->NumRefs == 0 && Pair.Value->LastUsedFrame < GFrameCounter)
+		{
+			EvictionCandidates.Emplace(Pair.Value->LastUsedFrame, Pair.Key);
+		}
+	}
+
+	// 한 번에 여유를 만들어 두어 상한 근처에서 매 팝업마다 훑지 않도록 함
+	const int32 NumToEvict = FMath::Min(TextCache.Num() - MaxCachedTexts * 3 / 4, EvictionCandidates.Num());
+	if (NumToEvict <= 0)
+	{
+		return;
+	}
+
+	EvictionCandidates.Sort([](const TPair<uint64, uint64>& A, const TPair<uint64, uint64>& B) { return A.Key < B.Key; });
+	for (int32 Index = 0; Index < NumToEvict; Index++)
+	{
+		TextCache.Remove(EvictionCandidates[Index].Value);
+	}
+	SET_DWORD_STAT(STAT_FloatingTextCachedStrings, TextCache.Num());
+}
+
+void UFloatingTextSubsystem::AddText(EFloatingTextKind Kind, int32 Value, const FVector& WorldLocation)
+{
+	if (!Layer.IsValid() || Value <= 0)
+	{
+		return;
+	}
+
+	FCachedText& Text = FindOrAddText(Kind, Value);
+
+	int32 SlotIndex;
+	if (NumActive < Entries.Num())
+	{
+		SlotIndex = (FirstActive + NumActive) % Entries.Num();
+		NumActive++;
+	}
+	else
+	{
+		// 풀이 가득 참: 가장 오래된 팝업 자리를 재사용
+		SlotIndex = FirstActive;
+		FirstActive = (FirstActive + 1) % Entries.Num();
+		NumOverwritten++;
+		INC_DWORD_STAT(STAT_FloatingTextOverwritten);
+	}
+
+	FFloatingTextEntry& Entry = Entries[SlotIndex];
+	if (Entry.Text)
+	{
+		Entry.Text->NumRefs--;
+	}
+	Text.NumRefs++;
+	Entry.WorldLocation = WorldLocation;
+	Entry.SpawnTime = GetWorld()->GetTimeSeconds();
+	Entry.Kind = Kind;
+	Entry.Text = &Text;
+}
+
+void UFloatingTextSubsystem::Tick(float DeltaTime)
+{
+	SCOPE_CYCLE_COUNTER(STAT_FloatingTextUpdate);
+
+	DrawItems.Reset();
+
+	const float Now = GetWorld()->GetTimeSeconds();
+	const int32 Capacity = Entries.Num();
+
+	// 만료된 팝업은 항상 원형 버퍼의 앞쪽에 모여 있음
+	while (NumActive > 0 && Now - Entries[FirstActive].SpawnTime >= Lifetime)
+	{
+		Entries[FirstActive].Text->NumRefs--;
+		Entries[FirstActive].Text = nullptr;
+		FirstActive = (FirstActive + 1) % Capacity;
+		NumActive--;
+	}
+
+	SET_DWORD_STAT(STAT_FloatingTextPoolSize, Capacity);
+	SET_DWORD_STAT(STAT_FloatingTextActive, NumActive);
+
+	const APlayerController* PlayerController = GetWorld()->GetFirstPlayerController();
+	if (NumActive == 0 || !PlayerController)
+	{
+		SET_DWORD_STAT(STAT_FloatingTextDrawn, 0);
+		return;
+	}
+
+	static const FLinearColor ScoreColor(1.0f, 0.85f, 0.1f);
+	static const FLinearColor DamageColor(1.0f, 0.2f, 0.15f);
+	const float FadeDuration = FMath::Max(Lifetime * (1.0f - FadeStart), UE_SMALL_NUMBER);
+
+	// 투영과 페이드를 한 번에 계산
+	for (int32 Offset = 0; Offset < NumActive; Offset++)
+	{
+		const FFloatingTextEntry& Entry = Entries[(FirstActive + Offset) % Capacity];
+		const float Age = Now - Entry.SpawnTime;
+		const FVector Location = Entry.WorldLocation + FVector(0.0f, 0.0f, RiseSpeed * Age);
+
+		FVector2D ScreenPosition;
+		if (!PlayerController->ProjectWorldLocationToScreen(Location, ScreenPosition))
+		{
+			continue;
+		}
+
+		FFloatingTextDrawItem& Item = DrawItems.AddDefaulted_GetRef();
+		Item.ScreenPosition = FVector2f(ScreenPosition);
+		Item.HalfSize = Entry.Text->HalfSize;
+		Item.Text = &Entry.Text->Text;
+		Entry.Text->LastUsedFrame = GFrameCounter;
+		Item.Color = Entry.Kind == EFloatingTextKind::Score ? ScoreColor : DamageColor;
+		Item.Color.A = FMath::Clamp(1.0f - (Age - Lifetime * FadeStart) / FadeDuration, 0.0f, 1.0f);
+	}
+
+	SET_DWORD_STAT(STAT_FloatingTextDrawn, DrawItems.Num());
+}
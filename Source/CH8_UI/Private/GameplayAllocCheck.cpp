@@ -0,0 +1,260 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "GameplayAllocCheck.h"
+
+#if !UE_BUILD_SHIPPING
+
+#include "HAL/IConsoleManager.h"
+#include "HAL/MemoryBase.h"
+#include "HAL/PlatformStackWalk.h"
+#include "Misc/CommandLine.h"
+#include "Misc/Parse.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogAllocCheck, Log, All);
+
+namespace CH8AllocCheck
+{
+	static const TCHAR* const ScopeNames[] = { TEXT("Spawn"), TEXT("Pickup"), TEXT("HUD"), TEXT("Detonation") };
+	static_assert(UE_ARRAY_COUNT(ScopeNames) == static_cast<int32>(EScope::Num), "ScopeNames must match EScope");
+
+	// 실패 원인을 찾을 수 있도록 측정 중 처음 몇 개 할당의 호출 스택을 남김 (할당 없이 고정 버퍼에)
+	static constexpr int32 MaxCapturedStacks = 4;
+	static constexpr int32 MaxStackDepth = 24;
+
+	// 아래 상태는 게임 스레드에서만 읽고 씀 (프록시는 IsInGameThread 확인 후에만 접근)
+	struct FCheckState
+	{
+		bool bEnabled = false;
+		int32 CurrentScope = INDEX_NONE;
+		int32 AllowDepth = 0;
+		bool bInCapture = false;
+		int64 Counts[static_cast<int32>(EScope::Num)] = {};
+		uint64 Stacks[MaxCapturedStacks][MaxStackDepth] = {};
+		int32 StackDepths[MaxCapturedStacks] = {};
+		int32 StackScopes[MaxCapturedStacks] = {};
+		int32 NumStacks = 0;
+		int32 NumMeasuredWaves = 0;
+		int32 NumFailedWaves = 0;
+	};
+	static FCheckState State;
+
+	static void CountAllocation()
+	{
+		if (State.CurrentScope == INDEX_NONE || State.AllowDepth > 0 || State.bInCapture || !IsInGameThread())
+		{
+			return;
+		}
+
+		State.Counts[State.CurrentScope]++;
+
+		if (State.NumStacks < MaxCapturedStacks)
+		{
+			TGuardValue<bool> CaptureGuard(State.bInCapture, true);
+			const int32 StackIndex = State.NumStacks++;
+			State.StackScopes[StackIndex] = State.CurrentScope;
+			State.StackDepths[StackIndex] = FPlatformStackWalk::CaptureStackBackTrace(State.Stacks[StackIndex], MaxStackDepth);
+		}
+	}
+
+	// 모든 호출을 원래 할당자로 넘기고 할당만 센다. 설치 이전에 할당된 메모리도 원래 할당자가 해제하므로 언제 끼워도 안전
+	class FMallocCountingProxy final : public FMalloc
+	{
+	public:
+		explicit FMallocCountingProxy(FMalloc* InMalloc) : UsedMalloc(InMalloc) {}
+
+		virtual void* Malloc(SIZE_T Size, uint32 Alignment) override
+		{
+			CountAllocation();
+			return UsedMalloc->Malloc(Size, Alignment);
+		}
+		virtual void* TryMalloc(SIZE_T Size, uint32 Alignment) override
+		{
+			CountAllocation();
+			return UsedMalloc->TryMalloc(Size, Alignment);
+		}
+		virtual void* Realloc(void* Ptr, SIZE_T NewSize, uint32 Alignment) override
+		{
+			if (NewSize > 0)
+			{
+				CountAllocation();
+			}
+			return UsedMalloc->Realloc(Ptr, NewSize, Alignment);
+		}
+		virtual void* TryRealloc(void* Ptr, SIZE_T NewSize, uint32 Alignment) override
+		{
+			if (NewSize > 0)
+			{
+				CountAllocation();
+			}
+			return UsedMalloc->TryRealloc(Ptr, NewSize, Alignment);
+		}
+		virtual void Free(void* Ptr) override { UsedMalloc->Free(Ptr); }
+		virtual SIZE_T QuantizeSize(SIZE_T Count, uint32 Alignment) override { return UsedMalloc->QuantizeSize(Count, Alignment); }
+		virtual bool GetAllocationSize(void* Original, SIZE_T& SizeOut) override { return UsedMalloc->GetAllocationSize(Original, SizeOut); }
+		virtual void Trim(bool bTrimThreadCaches) override { UsedMalloc->Trim(bTrimThreadCaches); }
+		virtual void SetupTLSCachesOnCurrentThread() override { UsedMalloc->SetupTLSCachesOnCurrentThread(); }
+		virtual void ClearAndDisableTLSCachesOnCurrentThread() override { UsedMalloc->ClearAndDisableTLSCachesOnCurrentThread(); }
+		virtual void InitializeStatsMetadata() override { UsedMalloc->InitializeStatsMetadata(); }
+		virtual void UpdateStats() override { UsedMalloc->UpdateStats(); }
+		virtual void GetAllocatorStats(FGenericMemoryStats& OutStats) override { UsedMalloc->GetAllocatorStats(OutStats); }
+		virtual void DumpAllocatorStats(FOutputDevice& Ar) override { UsedMalloc->DumpAllocatorStats(Ar); }
+		virtual bool IsInternallyThreadSafe() const override { return UsedMalloc->IsInternallyThreadSafe(); }
+		virtual bool ValidateHeap() override { return UsedMalloc->ValidateHeap(); }
+		virtual const TCHAR* GetDescriptiveName() override { return UsedMalloc->GetDescriptiveName(); }
+
+	private:
+		FMalloc* UsedMalloc;
+	};
+
+	static void ResetCounts()
+	{
+		FMemory::Memzero(State.Counts);
+		State.NumStacks = 0;
+	}
+
+	static void Enable()
+	{
+		if (State.bEnabled)
+		{
+			return;
+		}
+
+		// 프록시는 한 번 설치하면 프로세스가 끝날 때까지 둠 (꺼도 세기만 멈춤)
+		static FMallocCountingProxy* Proxy = nullptr;
+		if (!Proxy)
+		{
+			Proxy = new FMallocCountingProxy(GMalloc);
+			GMalloc = Proxy;
+		}
+
+		State.bEnabled = true;
+		State.NumMeasuredWaves = 0;
+		State.NumFailedWaves = 0;
+		ResetCounts();
+		UE_LOG(LogAllocCheck, Display, TEXT("Allocation check enabled: the first wave of each level warms up, later waves must not allocate"));
+	}
+
+	static void Disable()
+	{
+		State.bEnabled = false;
+		ResetCounts();
+	}
+
+	static TAutoConsoleVariable<bool> CVarAllocCheck(
+		TEXT("ch8.AllocCheck"),
+		false,
+		TEXT("웨이브의 스폰, 획득, HUD, 폭발 경로에서 게임 스레드 힙 할당을 세고 웨이브가 끝날 때 보고 (액터 생성/제거 제외)"),
+		FConsoleVariableDelegate::CreateLambda([](IConsoleVariable* Variable)
+		{
+			if (Variable->GetBool())
+			{
+				Enable();
+			}
+			else
+			{
+				Disable();
+			}
+		}));
+
+	static bool IsAutomationRun()
+	{
+		return FParse::Param(FCommandLine::Get(), TEXT("CH8AllocCheck"));
+	}
+
+	bool IsEnabled()
+	{
+		return State.bEnabled;
+	}
+
+	FScope::FScope(EScope Scope)
+		: PreviousScope(State.CurrentScope)
+	{
+		if (State.bEnabled)
+		{
+			State.CurrentScope = static_cast<int32>(Scope);
+		}
+	}
+
+	FScope::~FScope()
+	{
+		State.CurrentScope = PreviousScope;
+	}
+
+	FAllowScope::FAllowScope()
+	{
+		State.AllowDepth++;
+	}
+
+	FAllowScope::~FAllowScope()
+	{
+		State.AllowDepth--;
+	}
+
+	void OnLevelStarted()
+	{
+		if (!State.bEnabled && IsAutomationRun())
+		{
+			CVarAllocCheck->Set(true, ECVF_SetByCommandline);
+		}
+	}
+
+	void OnWaveEnded(int32 WaveIndex)
+	{
+		if (!State.bEnabled)
+		{
+			return;
+		}
+
+		// 보고(로그) 자체의 할당은 세지 않음
+		FAllowScope AllowReport;
+
+		if (WaveIndex == 0)
+		{
+			UE_LOG(LogAllocCheck, Display, TEXT("Warm-up wave finished, measuring from the next wave"));
+			ResetCounts();
+			return;
+		}
+
+		int64 Total = 0;
+		for (const int64 Count : State.Counts)
+		{
+			Total += Count;
+		}
+
+		State.NumMeasuredWaves++;
+		if (Total == 0)
+		{
+			UE_LOG(LogAllocCheck, Display, TEXT("Wave %d passed: no heap allocations in spawn, pickup, HUD or detonation"), WaveIndex + 1);
+		}
+		else
+		{
+			State.NumFailedWaves++;
+			UE_LOG(LogAllocCheck, Error, TEXT("Wave %d FAILED: %lld heap allocations (Spawn %lld, Pickup %lld, HUD %lld, Detonation %lld)"),
+				WaveIndex + 1, Total, State.Counts[0], State.Counts[1], State.Counts[2], State.Counts[3]);
+
+			for (int32 StackIndex = 0; StackIndex < State.NumStacks; StackIndex++)
+			{
+				UE_LOG(LogAllocCheck, Error, TEXT("Allocation %d in %s:"), StackIndex + 1, ScopeNames[State.StackScopes[StackIndex]]);
+				// 할당자와 이 파일의 프레임은 건너뜀
+				for (int32 Depth = 3; Depth < State.StackDepths[StackIndex]; Depth++)
+				{
+					ANSICHAR Symbol[512];
+					Symbol[0] = '\0';
+					FPlatformStackWalk::ProgramCounterToHumanReadableString(Depth, State.Stacks[StackIndex][Depth], Symbol, UE_ARRAY_COUNT(Symbol));
+					UE_LOG(LogAllocCheck, Error, TEXT("    %hs"), Symbol);
+				}
+			}
+		}
+		ResetCounts();
+
+		if (IsAutomationRun())
+		{
+			const bool bFailed = State.NumFailedWaves > 0;
+			UE_LOG(LogAllocCheck, Display, TEXT("Allocation check %s, exiting"), bFailed ? TEXT("failed") : TEXT("passed"));
+			FPlatformMisc::RequestExitWithStatus(false, bFailed ? 1 : 0);
+		}
+	}
+}
+
+#endif
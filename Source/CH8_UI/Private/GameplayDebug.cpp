@@ -0,0 +1,313 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "GameplayDebug.h"
+
+#if !UE_BUILD_SHIPPING
+
+#include "BaseGameState.h"
+#include "BaseItem.h"
+#include "CoinSpatialIndexSubsystem.h"
+#include "FloatingTextSubsystem.h"
+#include "GameplayEventSubsystem.h"
+#include "GameplaySchedulerSubsystem.h"
+#include "ItemEffectSubsystem.h"
+#include "RivalCollectorSubsystem.h"
+#include "SpawnGovernorSubsystem.h"
+#include "SpawnRecordSubsystem.h"
+#include "SpawnVolume.h"
+#include "StatusEffectSubsystem.h"
+#include "WaveSpawnPlannerSubsystem.h"
+#include "Debug/DebugDrawService.h"
+#include "Engine/Canvas.h"
+#include "Engine/DataTable.h"
+#include "Engine/Engine.h"
+#include "Engine/World.h"
+#include "EngineUtils.h"
+#include "GameFramework/PlayerController.h"
+#include "HAL/IConsoleManager.h"
+
+namespace CH8Debug
+{
+	static TAutoConsoleVariable<int32> CVarItemsPerWave(
+		TEXT("ch8.ItemsPerWave"),
+		0,
+		TEXT("다음 웨이브부터 스폰할 아이템 수. 0 이하이면 GameState 설정 사용"));
+
+	static TAutoConsoleVariable<float> CVarWaveDuration(
+		TEXT("ch8.WaveDuration"),
+		0.0f,
+		TEXT("다음 웨이브부터 적용할 웨이브 시간(초). 0 이하이면 GameState 설정 사용"));
+
+	struct FDebugStats
+	{
+		double LastWaveSpawnMs = 0.0;
+		int32 LastWaveItemCount = 0;
+		double LastHUDUpdateMs = 0.0;
+		double AverageHUDUpdateMs = 0.0;
+
+		// 초당 오버랩 이벤트 수는 1초마다 갱신
+		int64 OverlapCount = 0;
+		int64 OverlapCountAtSample = 0;
+		double OverlapSampleTime = 0.0;
+		float OverlapsPerSecond = 0.0f;
+	};
+	static FDebugStats Stats;
+
+	static FDelegateHandle OverlayHandle;
+
+	int32 GetItemsPerWaveOverride()
+	{
+		return CVarItemsPerWave.GetValueOnGameThread();
+	}
+
+	float GetWaveDurationOverride()
+	{
+		return CVarWaveDuration.GetValueOnGameThread();
+	}
+
+	void RecordWaveSpawnTime(double Milliseconds, int32 ItemCount)
+	{
+		Stats.LastWaveSpawnMs = Milliseconds;
+		Stats.LastWaveItemCount = ItemCount;
+	}
+
+	void RecordHUDUpdateTime(double Milliseconds)
+	{
+		Stats.LastHUDUpdateMs = Milliseconds;
+		Stats.AverageHUDUpdateMs = Stats.AverageHUDUpdateMs > 0.0 ? FMath::Lerp(Stats.AverageHUDUpdateMs, Milliseconds, 0.1) : Milliseconds;
+	}
+
+	void RecordOverlap()
+	{
+		Stats.OverlapCount++;
+	}
+
+	static ABaseGameState* GetGameState(UWorld* World)
+	{
+		return World ? World->GetGameState<ABaseGameState>() : nullptr;
+	}
+
+	static ASpawnVolume* FindSpawnVolume(UWorld* World)
+	{
+		TActorIterator<ASpawnVolume> It(World);
+		return It ? *It : nullptr;
+	}
+
+	static void DrawOverlay(UCanvas* Canvas, APlayerController* PlayerController)
+	{
+		UWorld* World = PlayerController ? PlayerController->GetWorld() : nullptr;
+		if (!Canvas || !World)
+		{
+			return;
+		}
+
+		const double Now = World->GetRealTimeSeconds();
+		if (Now - Stats.OverlapSampleTime >= 1.0)
+		{
+			Stats.OverlapsPerSecond = static_cast<float>((Stats.OverlapCount - Stats.OverlapCountAtSample) / (Now - Stats.OverlapSampleTime));
+			Stats.OverlapCountAtSample = Stats.OverlapCount;
+			Stats.OverlapSampleTime = Now;
+		}
+
+		TArray<FString, TInlineAllocator<24>> Lines;
+
+		if (const ABaseGameState* GameState = GetGameState(World))
+		{
+			Lines.Add(FString::Printf(TEXT("Level %d  Wave %d  Coins %d/%d"),
+				GameState->CurrentLevelIndex + 1, GameState->CurrentWave + 1, GameState->CollectedCoinCount, GameState->SpawnedCoinCount));
+		}
+
+		// 종류별 살아있는 아이템 수
+		const UItemEffectSubsystem* EffectSubsystem = World->GetSubsystem<UItemEffectSubsystem>();
+		TMap<FName, int32, TInlineSetAllocator<8>> ItemCounts;
+		int32 TotalItems = 0;
+		for (TActorIterator<ABaseItem> It(World); It; ++It)
+		{
+			const FName TypeName = EffectSubsystem ? EffectSubsystem->GetItemTypeName(It->GetItemTypeId()) : NAME_None;
+			ItemCounts.FindOrAdd(TypeName)++;
+			TotalItems++;
+		}
+		Lines.Add(FString::Printf(TEXT("Live items %d"), TotalItems));
+		for (const TPair<FName, int32>& Pair : ItemCounts)
+		{
+			Lines.Add(FString::Printf(TEXT("  %s: %d"), *Pair.Key.ToString(), Pair.Value));
+		}
+
+		Lines.Add(FString::Printf(TEXT("Last wave spawn %.2f ms (%d items)"), Stats.LastWaveSpawnMs, Stats.LastWaveItemCount));
+		Lines.Add(FString::Printf(TEXT("Overlaps/s %.0f"), Stats.OverlapsPerSecond));
+		Lines.Add(FString::Printf(TEXT("HUD update %.3f ms (avg %.3f ms)"), Stats.LastHUDUpdateMs, Stats.AverageHUDUpdateMs));
+
+		if (const USpawnGovernorSubsystem* SpawnGovernor = World->GetSubsystem<USpawnGovernorSubsystem>())
+		{
+			Lines.Add(FString::Printf(TEXT("Governor live %d / cap %d, %.3f ms/item, frame %.2f ms"),
+				SpawnGovernor->GetLiveItems(), SpawnGovernor->GetLiveItemCap(),
+				SpawnGovernor->GetCostPerItemMs(), SpawnGovernor->GetSmoothedFrameMs()));
+		}
+		if (const ASpawnVolume* SpawnVolume = FindSpawnVolume(World))
+		{
+			Lines.Add(FString::Printf(TEXT("Reachable spawn points %d, rejected %d, validated in %.2f ms"),
+				SpawnVolume->GetNumReachablePoints(), SpawnVolume->GetNumRejectedPoints(), SpawnVolume->GetLastValidationMs()));
+			if (SpawnVolume->GetNumRegionTriangles() > 0)
+			{
+				Lines.Add(FString::Printf(TEXT("Spawn region %d triangles, built in %.2f ms"),
+					SpawnVolume->GetNumRegionTriangles(), SpawnVolume->GetLastRegionBuildMs()));
+			}
+		}
+		if (const UWaveSpawnPlannerSubsystem* SpawnPlanner = World->GetSubsystem<UWaveSpawnPlannerSubsystem>())
+		{
+			Lines.Add(FString::Printf(TEXT("Wave plans precomputed %d, fallbacks %d, unplanned %d, last %.2f ms"),
+				SpawnPlanner->GetNumPrecomputed(), SpawnPlanner->GetNumFallbacks(), SpawnPlanner->GetNumUnplanned(), SpawnPlanner->GetLastPlanMs()));
+		}
+		if (const USpawnRecordSubsystem* SpawnRecords = World->GetSubsystem<USpawnRecordSubsystem>())
+		{
+			Lines.Add(FString::Printf(TEXT("Spawn records %d, live %d (peak %d), waiting %d, unloaded cells %d"),
+				SpawnRecords->GetNumRecords(), SpawnRecords->GetNumLive(), SpawnRecords->GetPeakLive(),
+				SpawnRecords->GetNumPending(), SpawnRecords->GetNumUnloadedCells()));
+		}
+		if (const UFloatingTextSubsystem* FloatingText = World->GetSubsystem<UFloatingTextSubsystem>())
+		{
+			Lines.Add(FString::Printf(TEXT("Floating text %d / %d, overwritten %d"),
+				FloatingText->GetNumActive(), FloatingText->GetPoolSize(), FloatingText->GetNumOverwritten()));
+		}
+		if (EffectSubsystem)
+		{
+			Lines.Add(FString::Printf(TEXT("Item types %d, pending effects %d"), EffectSubsystem->GetNumItemTypes(), EffectSubsystem->GetNumPendingEffects()));
+		}
+		if (const UStatusEffectSubsystem* StatusEffects = World->GetSubsystem<UStatusEffectSubsystem>())
+		{
+			Lines.Add(FString::Printf(TEXT("Status effects %d"), StatusEffects->GetNumActiveEffects()));
+		}
+		if (const URivalCollectorSubsystem* Rivals = World->GetSubsystem<URivalCollectorSubsystem>())
+		{
+			Lines.Add(FString::Printf(TEXT("Rivals %d, total score %d, best %d, tick %.3f ms"),
+				Rivals->GetNumRivals(), Rivals->GetTotalRivalScore(), Rivals->GetBestRivalScore(), Rivals->GetAverageTickMs()));
+		}
+		if (const UGameplaySchedulerSubsystem* Scheduler = World->GetSubsystem<UGameplaySchedulerSubsystem>())
+		{
+			Lines.Add(FString::Printf(TEXT("Scheduled timers %d"), Scheduler->GetNumPending()));
+		}
+		if (const UCoinSpatialIndexSubsystem* SpatialIndex = World->GetSubsystem<UCoinSpatialIndexSubsystem>())
+		{
+			Lines.Add(FString::Printf(TEXT("Indexed coins %d"), SpatialIndex->GetNumCoins()));
+		}
+		if (const UGameplayEventSubsystem* EventLog = UGameInstance::GetSubsystem<UGameplayEventSubsystem>(World->GetGameInstance()))
+		{
+			Lines.Add(FString::Printf(TEXT("Event log dropped %llu"), EventLog->GetDroppedCount()));
+		}
+
+		UFont* Font = GEngine->GetSmallFont();
+		const float LineHeight = Font->GetMaxCharHeight() + 2.0f;
+		float Y = Canvas->ClipY * 0.2f;
+		Canvas->SetDrawColor(FColor::Yellow);
+		for (const FString& Line : Lines)
+		{
+			Canvas->DrawText(Font, Line, 20.0f, Y);
+			Y += LineHeight;
+		}
+	}
+
+	static void OnShowOverlayChanged(IConsoleVariable* Variable)
+	{
+		const bool bShow = Variable->GetBool();
+		if (bShow && !OverlayHandle.IsValid())
+		{
+			OverlayHandle = UDebugDrawService::Register(TEXT("Game"), FDebugDrawDelegate::CreateStatic(&DrawOverlay));
+		}
+		else if (!bShow && OverlayHandle.IsValid())
+		{
+			UDebugDrawService::Unregister(OverlayHandle);
+			OverlayHandle.Reset();
+		}
+	}
+
+	static TAutoConsoleVariable<bool> CVarShowOverlay(
+		TEXT("ch8.ShowOverlay"),
+		false,
+		TEXT("아이템 수, 스폰 시간, 오버랩 빈도, HUD 갱신 비용, 풀/캐시 상태 오버레이 표시"),
+		FConsoleVariableDelegate::CreateStatic(&OnShowOverlayChanged));
+
+	static FAutoConsoleCommandWithWorldAndArgs SpawnItemsCommand(
+		TEXT("ch8.SpawnItems"),
+		TEXT("ch8.SpawnItems <RowName> [Count=1] - 스폰 DataTable 의 행으로 아이템을 강제 스폰 (웨이브 코인 수에는 포함되지 않음)"),
+		FConsoleCommandWithWorldAndArgsDelegate::CreateStatic([](const TArray<FString>& Args, UWorld* World)
+		{
+			ASpawnVolume* SpawnVolume = FindSpawnVolume(World);
+			const UDataTable* ItemDataTable = SpawnVolume ? SpawnVolume->GetItemDataTable() : nullptr;
+			if (Args.IsEmpty() || !ItemDataTable)
+			{
+				UE_LOG(LogTemp, Warning, TEXT("ch8.SpawnItems: needs a row name and a SpawnVolume with an ItemDataTable"));
+				return;
+			}
+
+			static const FString ContextString(TEXT("DebugSpawnContext"));
+			const FItemSpawnRow* Row = ItemDataTable->FindRow<FItemSpawnRow>(FName(*Args[0]), ContextString, false);
+			if (!Row)
+			{
+				UE_LOG(LogTemp, Warning, TEXT("ch8.SpawnItems: no row %s in %s"), *Args[0], *ItemDataTable->GetName());
+				return;
+			}
+
+			const int32 Count = Args.IsValidIndex(1) ? FMath::Max(FCString::Atoi(*Args[1]), 1) : 1;
+			const double StartTime = FPlatformTime::Seconds();
+			for (int32 Index = 0; Index < Count; Index++)
+			{
+				SpawnVolume->SpawnItemFromRow(*Row);
+			}
+			UE_LOG(LogTemp, Display, TEXT("ch8.SpawnItems: spawned %d x %s in %.2f ms"), Count, *Args[0], (FPlatformTime::Seconds() - StartTime) * 1000.0);
+		}));
+
+	static FAutoConsoleCommandWithWorldAndArgs SkipToWaveCommand(
+		TEXT("ch8.SkipToWave"),
+		TEXT("ch8.SkipToWave <N> - 현재 레벨의 N 번째 웨이브(1부터)를 바로 시작"),
+		FConsoleCommandWithWorldAndArgsDelegate::CreateStatic([](const TArray<FString>& Args, UWorld* World)
+		{
+			if (ABaseGameState* GameState = GetGameState(World))
+			{
+				GameState->DebugSkipToWave(Args.IsEmpty() ? GameState->CurrentWave + 1 : FCString::Atoi(*Args[0]) - 1);
+			}
+		}));
+
+	static FAutoConsoleCommandWithWorldAndArgs SkipToLevelCommand(
+		TEXT("ch8.SkipToLevel"),
+		TEXT("ch8.SkipToLevel <N> - N 번째 레벨(1부터) 맵을 열고 첫 웨이브부터 시작"),
+		FConsoleCommandWithWorldAndArgsDelegate::CreateStatic([](const TArray<FString>& Args, UWorld* World)
+		{
+			if (ABaseGameState* GameState = GetGameState(World))
+			{
+				GameState->DebugSkipToLevel(Args.IsEmpty() ? GameState->CurrentLevelIndex + 1 : FCString::Atoi(*Args[0]) - 1);
+			}
+		}));
+
+	static FAutoConsoleCommandWithWorldAndArgs RivalBenchmarkCommand(
+		TEXT("ch8.RivalBenchmark"),
+		TEXT("ch8.RivalBenchmark [MaxRivals=500] [Step=100] [FramesPerStep=120] - 라이벌 수를 늘려가며 게임 스레드 비용을 재고 Saved/Benchmarks 에 CSV 로 기록"),
+		FConsoleCommandWithWorldAndArgsDelegate::CreateStatic([](const TArray<FString>& Args, UWorld* World)
+		{
+			if (URivalCollectorSubsystem* Rivals = World ? World->GetSubsystem<URivalCollectorSubsystem>() : nullptr)
+			{
+				Rivals->DebugStartBenchmark(
+					Args.IsValidIndex(0) ? FCString::Atoi(*Args[0]) : 500,
+					Args.IsValidIndex(1) ? FCString::Atoi(*Args[1]) : 100,
+					Args.IsValidIndex(2) ? FCString::Atoi(*Args[2]) : 120);
+			}
+		}));
+
+	static FAutoConsoleCommandWithWorld ClearItemsCommand(
+		TEXT("ch8.ClearItems"),
+		TEXT("ch8.ClearItems - 월드의 모든 아이템과 보류 중인 스폰 제거 (웨이브 중이면 현재 웨이브를 다시 시작)"),
+		FConsoleCommandWithWorldDelegate::CreateStatic([](UWorld* World)
+		{
+			if (ABaseGameState* GameState = GetGameState(World))
+			{
+				GameState->ClearAllItems();
+				// 필요한 코인이 사라져 웨이브를 끝낼 수 없게 되므로 같은 웨이브를 새로 시작
+				if (GameState->IsWaveActive())
+				{
+					GameState->DebugSkipToWave(GameState->CurrentWave);
+				}
+			}
+		}));
+}
+
+#endif
@@ -0,0 +1,120 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "GameplayEventDecodeCommandlet.h"
+#include "GameplayEventLog.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+
+UGameplayEventDecodeCommandlet::UGameplayEventDecodeCommandlet()
+{
+	IsClient = false;
+	IsServer = false;
+	IsEditor = false;
+	LogToConsole = true;
+}
+
+int32 UGameplayEventDecodeCommandlet::Main(const FString& Params)
+{
+	FString InPath;
+	if (!FParse::Value(*Params, TEXT("In="), InPath))
+	{
+		UE_LOG(LogTemp, Error, TEXT("Usage: -run=GameplayEventDecode -In=<Events.ch8ev> [-Out=<Events.csv>]"));
+		return 1;
+	}
+
+	FString OutPath;
+	if (!FParse::Value(*Params, TEXT("Out="), OutPath))
+	{
+		OutPath = FPaths::ChangeExtension(InPath, TEXT("csv"));
+	}
+
+	TArray<uint8> Data;
+	if (!FFileHelper::LoadFileToArray(Data, *InPath))
+	{
+		UE_LOG(LogTemp, Error, TEXT("Failed to read %s"), *InPath);
+		return 1;
+	}
+
+	using FFileHeader = FGameplayEventLog::FFileHeader;
+	using FBlockHeader = FGameplayEventLog::FBlockHeader;
+
+	if (Data.Num() < static_cast<int32>(sizeof(FFileHeader)))
+	{
+		UE_LOG(LogTemp, Error, TEXT("%s is too small to be a gameplay event log"), *InPath);
+		return 1;
+	}
+
+	FFileHeader Header;
+	FMemory::Memcpy(&Header, Data.GetData(), sizeof(Header));
+	if (Header.Magic != FGameplayEventLog::FileMagic || Header.Version != FGameplayEventLog::FileVersion || Header.RecordSize != sizeof(FGameplayEventRecord))
+	{
+		UE_LOG(LogTemp, Error, TEXT("%s has an unsupported header (version %u, record size %u)"), *InPath, Header.Version, Header.RecordSize);
+		return 1;
+	}
+
+	TMap<uint32, FString> Names;
+	TArray<FString> Lines;
+	Lines.Add(TEXT("Time,Type,Name,A,B,Value"));
+
+	int64 Offset = sizeof(FFileHeader);
+	int64 RecordCount = 0;
+	int64 LastDropped = 0;
+	while (Offset + static_cast<int64>(sizeof(FBlockHeader)) <= Data.Num())
+	{
+		FBlockHeader Block;
+		FMemory::Memcpy(&Block, Data.GetData() + Offset, sizeof(Block));
+		Offset += sizeof(Block);
+
+		if (Block.Type == FGameplayEventLog::EBlockType::Name)
+		{
+			if (Offset + Block.Count > Data.Num())
+			{
+				break;
+			}
+			const FUTF8ToTCHAR Converted(reinterpret_cast<const ANSICHAR*>(Data.GetData() + Offset), Block.Count);
+			Names.Add(Block.NameId, FString(Converted.Length(), Converted.Get()));
+			Offset += Block.Count;
+		}
+		else if (Block.Type == FGameplayEventLog::EBlockType::Records)
+		{
+			const int64 BlockBytes = static_cast<int64>(Block.Count) * sizeof(FGameplayEventRecord);
+			if (Offset + BlockBytes > Data.Num())
+			{
+				// 기록 도중 종료된 파일. 완전한 레코드만 읽음
+				Block.Count = static_cast<uint32>((Data.Num() - Offset) / static_cast<int64>(sizeof(FGameplayEventRecord)));
+			}
+
+			for (uint32 Index = 0; Index < Block.Count; Index++)
+			{
+				FGameplayEventRecord Record;
+				FMemory::Memcpy(&Record, Data.GetData() + Offset, sizeof(Record));
+				Offset += sizeof(Record);
+
+				const FString* Name = Record.NameId != 0 ? Names.Find(Record.NameId) : nullptr;
+				Lines.Add(FString::Printf(TEXT("%.4f,%s,%s,%d,%d,%g"),
+					Record.Time, LexToString(Record.Type), Name ? **Name : TEXT(""), Record.A, Record.B, Record.Value));
+
+				if (Record.Type == EGameplayEventType::Dropped)
+				{
+					LastDropped = Record.A;
+				}
+				RecordCount++;
+			}
+		}
+		else
+		{
+			UE_LOG(LogTemp, Warning, TEXT("Unknown block type %u at offset %lld, stopping"), static_cast<uint32>(Block.Type), Offset);
+			break;
+		}
+	}
+
+	if (!FFileHelper::SaveStringArrayToFile(Lines, *OutPath))
+	{
+		UE_LOG(LogTemp, Error, TEXT("Failed to write %s"), *OutPath);
+		return 1;
+	}
+
+	UE_LOG(LogTemp, Display, TEXT("Decoded %lld events (%lld dropped) to %s"), RecordCount, LastDropped, *OutPath);
+	return 0;
+}
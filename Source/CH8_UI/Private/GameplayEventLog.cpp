@@ -0,0 +1,195 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "GameplayEventLog.h"
+#include "HAL/PlatformFileManager.h"
+#include "HAL/RunnableThread.h"
+#include "Misc/Paths.h"
+
+FGameplayEventLog::FGameplayEventLog(const FString& InFilePath, uint32 CapacityPow2)
+	: FilePath(InFilePath)
+{
+	const uint32 Capacity = FMath::RoundUpToPowerOfTwo(FMath::Max<uint32>(CapacityPow2, 64));
+	Ring.SetNumZeroed(Capacity);
+	RingMask = Capacity - 1;
+	WriteBuffer.Reserve(Capacity);
+	StartTime = FPlatformTime::Seconds();
+
+	IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+	PlatformFile.CreateDirectoryTree(*FPaths::GetPath(FilePath));
+	FileHandle.Reset(PlatformFile.OpenWrite(*FilePath));
+	if (!FileHandle)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("Failed to open gameplay event log %s"), *FilePath);
+		return;
+	}
+
+	FFileHeader Header;
+	Header.StartUtcTicks = FDateTime::UtcNow().GetTicks();
+	FileHandle->Write(reinterpret_cast<const uint8*>(&Header), sizeof(Header));
+
+	Thread = FRunnableThread::Create(this, TEXT("GameplayEventWriter"), 0, TPri_BelowNormal);
+}
+
+FGameplayEventLog::~FGameplayEventLog()
+{
+	if (Thread)
+	{
+		// Kill 은 Stop 을 호출하고 Run 이 끝날 때까지 기다림 (남은 이벤트는 Run 에서 마저 기록)
+		Thread->Kill(true);
+		delete Thread;
+		Thread = nullptr;
+	}
+
+	if (FileHandle)
+	{
+		FileHandle->Flush();
+		FileHandle.Reset();
+	}
+
+	const uint64 Dropped = GetDroppedCount();
+	if (Dropped > 0)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("Gameplay event log dropped %llu events (ring overflow)"), Dropped);
+	}
+}
+
+bool FGameplayEventLog::Push(EGameplayEventType Type, int32 A, int32 B, float Value, FName Name)
+{
+	checkSlow(IsInGameThread());
+
+	if (!Thread)
+	{
+		DroppedCount.fetch_add(1, std::memory_order_relaxed);
+		return false;
+	}
+
+	const uint32 CurrentHead = Head.load(std::memory_order_relaxed);
+	const uint32 CurrentTail = Tail.load(std::memory_order_acquire);
+	if (CurrentHead - CurrentTail > RingMask)
+	{
+		DroppedCount.fetch_add(1, std::memory_order_relaxed);
+		return false;
+	}
+
+	FGameplayEventRecord& Record = Ring[CurrentHead & RingMask];
+	Record.Time = FPlatformTime::Seconds() - StartTime;
+	Record.Type = Type;
+	Record.Flags = 0;
+	Record.NameId = Name.IsNone() ? 0 : FindOrAddNameId(Name);
+	Record.A = A;
+	Record.B = B;
+	Record.Value = Value;
+
+	Head.store(CurrentHead + 1, std::memory_order_release);
+	return true;
+}
+
+uint16 FGameplayEventLog::FindOrAddNameId(FName Name)
+{
+	if (const uint16* ExistingId = NameIds.Find(Name))
+	{
+		return *ExistingId;
+	}
+
+	if (NameIds.Num() >= MAX_uint16)
+	{
+		return 0;
+	}
+
+	const uint16 NewId = static_cast<uint16>(NameIds.Num() + 1);
+	NameIds.Add(Name, NewId);
+	// 레코드보다 먼저 큐에 넣어야 기록 스레드가 이름 블록을 먼저 씀
+	PendingNames.Enqueue(TPair<uint16, FString>(NewId, Name.ToString()));
+	return NewId;
+}
+
+uint32 FGameplayEventLog::Run()
+{
+	while (!bStopRequested.load(std::memory_order_relaxed))
+	{
+		Drain();
+		FPlatformProcess::SleepNoStats(0.05f);
+	}
+
+	Drain();
+	return 0;
+}
+
+void FGameplayEventLog::Stop()
+{
+	bStopRequested.store(true, std::memory_order_relaxed);
+}
+
+void FGameplayEventLog::Drain()
+{
+	const uint32 CurrentHead = Head.load(std::memory_order_acquire);
+	uint32 CurrentTail = Tail.load(std::memory_order_relaxed);
+
+	WriteNames();
+
+	WriteBuffer.Reset();
+	while (CurrentTail != CurrentHead)
+	{
+		WriteBuffer.Add(Ring[CurrentTail & RingMask]);
+		CurrentTail++;
+	}
+	Tail.store(CurrentTail, std::memory_order_release);
+
+	const uint64 Dropped = GetDroppedCount();
+	if (Dropped != LastReportedDropped)
+	{
+		FGameplayEventRecord& DroppedRecord = WriteBuffer.AddDefaulted_GetRef();
+		DroppedRecord.Time = FPlatformTime::Seconds() - StartTime;
+		DroppedRecord.Type = EGameplayEventType::Dropped;
+		DroppedRecord.A = static_cast<int32>(FMath::Min<uint64>(Dropped, MAX_int32));
+		LastReportedDropped = Dropped;
+	}
+
+	if (WriteBuffer.IsEmpty())
+	{
+		return;
+	}
+
+	FBlockHeader Block;
+	Block.Type = EBlockType::Records;
+	Block.Count = WriteBuffer.Num();
+	FileHandle->Write(reinterpret_cast<const uint8*>(&Block), sizeof(Block));
+	FileHandle->Write(reinterpret_cast<const uint8*>(WriteBuffer.GetData()), WriteBuffer.Num() * sizeof(FGameplayEventRecord));
+	WrittenCount.fetch_add(WriteBuffer.Num(), std::memory_order_relaxed);
+}
+
+void FGameplayEventLog::WriteNames()
+{
+	TPair<uint16, FString> PendingName;
+	while (PendingNames.Dequeue(PendingName))
+	{
+		const FTCHARToUTF8 Utf8Name(*PendingName.Value);
+
+		FBlockHeader Block;
+		Block.Type = EBlockType::Name;
+		Block.Count = Utf8Name.Length();
+		Block.NameId = PendingName.Key;
+		FileHandle->Write(reinterpret_cast<const uint8*>(&Block), sizeof(Block));
+		FileHandle->Write(reinterpret_cast<const uint8*>(Utf8Name.Get()), Utf8Name.Length());
+	}
+}
+
+const TCHAR* LexToString(EGameplayEventType Type)
+{
+	switch (Type)
+	{
+	case EGameplayEventType::Pickup:		return TEXT("Pickup");
+	case EGameplayEventType::Damage:		return TEXT("Damage");
+	case EGameplayEventType::Heal:			return TEXT("Heal");
+	case EGameplayEventType::Score:			return TEXT("Score");
+	case EGameplayEventType::WaveStart:		return TEXT("WaveStart");
+	case EGameplayEventType::WaveEnd:		return TEXT("WaveEnd");
+	case EGameplayEventType::LevelChange:	return TEXT("LevelChange");
+	case EGameplayEventType::Death:			return TEXT("Death");
+	case EGameplayEventType::Explode:		return TEXT("Explode");
+	case EGameplayEventType::Dropped:		return TEXT("Dropped");
+	case EGameplayEventType::Spawn:			return TEXT("Spawn");
+	default:								return TEXT("None");
+	}
+}
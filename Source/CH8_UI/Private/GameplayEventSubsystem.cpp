@@ -0,0 +1,68 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "GameplayEventSubsystem.h"
+#include "Engine/GameInstance.h"
+#include "Engine/World.h"
+#include "Misc/CommandLine.h"
+#include "Misc/Paths.h"
+
+bool UGameplayEventSubsystem::ShouldCreateSubsystem(UObject* Outer) const
+{
+	return !FParse::Param(FCommandLine::Get(), TEXT("NoGameplayEventLog"));
+}
+
+void UGameplayEventSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	const FString FilePath = FPaths::ProjectSavedDir() / TEXT("GameplayEvents")
+		/ FString::Printf(TEXT("Events-%s.ch8ev"), *FDateTime::Now().ToString());
+	EventLog = MakeUnique<FGameplayEventLog>(FilePath);
+}
+
+void UGameplayEventSubsystem::Deinitialize()
+{
+	EventLog.Reset();
+
+	Super::Deinitialize();
+}
+
+void UGameplayEventSubsystem::Record(EGameplayEventType Type, int32 A, int32 B, float Value, FName Name)
+{
+	if (EventLog)
+	{
+		EventLog->Push(Type, A, B, Value, Name);
+	}
+
+	FRecentGameplayEvent& Recent = RecentEvents[RecentEventCount++ % NumRecentEvents];
+	Recent.Time = FPlatformTime::Seconds();
+	Recent.Type = Type;
+	Recent.A = A;
+	Recent.B = B;
+	Recent.Value = Value;
+	Recent.Name = Name;
+}
+
+void UGameplayEventSubsystem::Record(const UObject* WorldContextObject, EGameplayEventType Type, int32 A, int32 B, float Value, FName Name)
+{
+	const UWorld* World = WorldContextObject ? WorldContextObject->GetWorld() : nullptr;
+	if (UGameplayEventSubsystem* EventSubsystem = UGameInstance::GetSubsystem<UGameplayEventSubsystem>(World ? World->GetGameInstance() : nullptr))
+	{
+		EventSubsystem->Record(Type, A, B, Value, Name);
+	}
+}
+
+uint64 UGameplayEventSubsystem::GetDroppedCount() const
+{
+	return EventLog ? EventLog->GetDroppedCount() : 0;
+}
+
+void UGameplayEventSubsystem::GetRecentEvents(TArray<FRecentGameplayEvent>& OutEvents) const
+{
+	const uint32 Count = FMath::Min<uint32>(RecentEventCount, NumRecentEvents);
+	for (uint32 Index = RecentEventCount - Count; Index != RecentEventCount; Index++)
+	{
+		OutEvents.Add(RecentEvents[Index % NumRecentEvents]);
+	}
+}
@@ -0,0 +1,19 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "GameplayLLMTags.h"
+
+LLM_DEFINE_TAG(CH8Items);
+LLM_DEFINE_TAG(CH8UI);
+LLM_DEFINE_TAG(CH8Spawn);
+
+int64 CH8LLM::GetTagAmount(const TCHAR* TagName)
+{
+#if ENABLE_LOW_LEVEL_MEM_TRACKER
+	if (FLowLevelMemTracker::IsEnabled())
+	{
+		return FLowLevelMemTracker::Get().GetTagAmountForTracker(ELLMTracker::Default, FName(TagName), ELLMTagSet::None);
+	}
+#endif
+	return -1;
+}
@@ -0,0 +1,255 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "GameplayMetrics.h"
+
+#if !UE_BUILD_SHIPPING
+
+#include "HttpPath.h"
+#include "HttpRouteHandle.h"
+#include "HttpServerModule.h"
+#include "HttpServerResponse.h"
+#include "IHttpRouter.h"
+#include "Misc/CommandLine.h"
+#include "Misc/CoreDelegates.h"
+#include "Misc/Parse.h"
+#include "RenderCore.h"
+#include <atomic>
+
+DEFINE_LOG_CATEGORY_STATIC(LogGameplayMetrics, Log, All);
+
+namespace CH8Metrics
+{
+	// 프레임 시간 히스토그램 구간 상한 (ms). 마지막 구간(+Inf)은 따로
+	static constexpr double FrameBucketBoundsMs[] = { 8.0, 16.7, 33.3, 50.0, 100.0, 250.0 };
+	static constexpr int32 NumFrameBuckets = UE_ARRAY_COUNT(FrameBucketBoundsMs) + 1;
+	// 웨이브 인덱스별 마지막 스폰/정리 시간 (이보다 큰 인덱스는 마지막 칸에)
+	static constexpr int32 MaxWaves = 8;
+	// 아이템 종류별 개수 (ID 가 이보다 크면 0번 칸에 모음)
+	static constexpr int32 MaxItemTypes = 64;
+
+	// 아래 값은 모두 relaxed 로 읽고 씀. 값 사이의 일관성은 필요 없음 (긁어가는 쪽은 각 값을 독립적으로 봄)
+	struct FCounters
+	{
+		std::atomic<uint64> FrameBuckets[NumFrameBuckets] = {};
+		std::atomic<uint64> FrameCount { 0 };
+		std::atomic<double> FrameSumMs { 0.0 };
+
+		std::atomic<int32> LevelIndex { INDEX_NONE };
+		std::atomic<int32> WaveIndex { INDEX_NONE };
+		std::atomic<int32> TotalScore { 0 };
+
+		std::atomic<double> LastSpawnMs[MaxWaves] = {};
+		std::atomic<double> LastClearMs[MaxWaves] = {};
+		std::atomic<double> SpawnSumMs { 0.0 };
+		std::atomic<uint64> SpawnCount { 0 };
+		std::atomic<double> ClearSumMs { 0.0 };
+		std::atomic<uint64> ClearCount { 0 };
+
+		std::atomic<uint64> Pickups { 0 };
+		std::atomic<uint64> DamageEvents { 0 };
+		std::atomic<double> DamageTotal { 0.0 };
+
+		std::atomic<int32> LiveItems[MaxItemTypes] = {};
+	};
+	static FCounters Counters;
+
+	// 아래는 게임 스레드 전용 (HTTP 서버도 게임 스레드에서 요청을 처리)
+	struct FServerState
+	{
+		uint32 Port = 0;
+		TSharedPtr<IHttpRouter> Router;
+		FHttpRouteHandle RouteHandle;
+		FDelegateHandle EndFrameHandle;
+		FName ItemTypeNames[MaxItemTypes];
+	};
+	static FServerState Server;
+
+	template <typename T>
+	static void AtomicAdd(std::atomic<T>& Value, T Amount)
+	{
+		// double 은 fetch_add 가 없으므로 CAS 반복
+		T Expected = Value.load(std::memory_order_relaxed);
+		while (!Value.compare_exchange_weak(Expected, Expected + Amount, std::memory_order_relaxed))
+		{
+		}
+	}
+
+	static void OnEndFrame()
+	{
+		// 직전 프레임의 게임 스레드 작업 시간 (HitchWatchdog 과 같은 기준, 대기 시간 제외)
+		const double FrameMs = FPlatformTime::ToMilliseconds(GGameThreadTime);
+
+		int32 Bucket = 0;
+		while (Bucket < NumFrameBuckets - 1 && FrameMs > FrameBucketBoundsMs[Bucket])
+		{
+			Bucket++;
+		}
+		Counters.FrameBuckets[Bucket].fetch_add(1, std::memory_order_relaxed);
+		Counters.FrameCount.fetch_add(1, std::memory_order_relaxed);
+		AtomicAdd(Counters.FrameSumMs, FrameMs);
+	}
+
+	static FString FormatMetrics()
+	{
+		FString Out;
+		Out.Reserve(4096);
+
+		Out += TEXT("# HELP ch8_frame_time_ms Game thread frame time.\n# TYPE ch8_frame_time_ms histogram\n");
+		uint64 Cumulative = 0;
+		for (int32 Bucket = 0; Bucket < NumFrameBuckets; Bucket++)
+		{
+			Cumulative += Counters.FrameBuckets[Bucket].load(std::memory_order_relaxed);
+			if (Bucket < NumFrameBuckets - 1)
+			{
+				Out += FString::Printf(TEXT("ch8_frame_time_ms_bucket{le=\"%g\"} %llu\n"), FrameBucketBoundsMs[Bucket], Cumulative);
+			}
+			else
+			{
+				Out += FString::Printf(TEXT("ch8_frame_time_ms_bucket{le=\"+Inf\"} %llu\n"), Cumulative);
+			}
+		}
+		Out += FString::Printf(TEXT("ch8_frame_time_ms_sum %.3f\nch8_frame_time_ms_count %llu\n"),
+			Counters.FrameSumMs.load(std::memory_order_relaxed), Counters.FrameCount.load(std::memory_order_relaxed));
+
+		Out += FString::Printf(TEXT("# TYPE ch8_level gauge\nch8_level %d\n"), Counters.LevelIndex.load(std::memory_order_relaxed));
+		Out += FString::Printf(TEXT("# TYPE ch8_wave gauge\nch8_wave %d\n"), Counters.WaveIndex.load(std::memory_order_relaxed));
+		Out += FString::Printf(TEXT("# TYPE ch8_total_score gauge\nch8_total_score %d\n"), Counters.TotalScore.load(std::memory_order_relaxed));
+
+		Out += TEXT("# HELP ch8_live_items Live item actors by ItemType.\n# TYPE ch8_live_items gauge\n");
+		for (int32 TypeId = 0; TypeId < MaxItemTypes; TypeId++)
+		{
+			const int32 Count = Counters.LiveItems[TypeId].load(std::memory_order_relaxed);
+			if (Count != 0 || !Server.ItemTypeNames[TypeId].IsNone())
+			{
+				Out += FString::Printf(TEXT("ch8_live_items{type=\"%s\"} %d\n"),
+					TypeId == 0 ? TEXT("other") : *Server.ItemTypeNames[TypeId].ToString(), Count);
+			}
+		}
+
+		Out += TEXT("# HELP ch8_wave_spawn_ms Time to spawn the last wave with this index.\n# TYPE ch8_wave_spawn_ms gauge\n");
+		for (int32 Wave = 0; Wave < MaxWaves; Wave++)
+		{
+			Out += FString::Printf(TEXT("ch8_wave_spawn_ms{wave=\"%d\"} %.3f\n"), Wave, Counters.LastSpawnMs[Wave].load(std::memory_order_relaxed));
+		}
+		Out += FString::Printf(TEXT("ch8_wave_spawn_ms_sum %.3f\nch8_wave_spawn_ms_count %llu\n"),
+			Counters.SpawnSumMs.load(std::memory_order_relaxed), Counters.SpawnCount.load(std::memory_order_relaxed));
+
+		Out += TEXT("# HELP ch8_wave_clear_ms Time to clear the items of the last wave with this index.\n# TYPE ch8_wave_clear_ms gauge\n");
+		for (int32 Wave = 0; Wave < MaxWaves; Wave++)
+		{
+			Out += FString::Printf(TEXT("ch8_wave_clear_ms{wave=\"%d\"} %.3f\n"), Wave, Counters.LastClearMs[Wave].load(std::memory_order_relaxed));
+		}
+		Out += FString::Printf(TEXT("ch8_wave_clear_ms_sum %.3f\nch8_wave_clear_ms_count %llu\n"),
+			Counters.ClearSumMs.load(std::memory_order_relaxed), Counters.ClearCount.load(std::memory_order_relaxed));
+
+		// 비율은 긁어가는 쪽에서 누적값의 변화율로 계산
+		Out += FString::Printf(TEXT("# TYPE ch8_pickups_total counter\nch8_pickups_total %llu\n"), Counters.Pickups.load(std::memory_order_relaxed));
+		Out += FString::Printf(TEXT("# TYPE ch8_damage_events_total counter\nch8_damage_events_total %llu\n"), Counters.DamageEvents.load(std::memory_order_relaxed));
+		Out += FString::Printf(TEXT("# TYPE ch8_damage_total counter\nch8_damage_total %.1f\n"), Counters.DamageTotal.load(std::memory_order_relaxed));
+
+		return Out;
+	}
+
+	static bool HandleMetricsRequest(const FHttpServerRequest& Request, const FHttpResultCallback& OnComplete)
+	{
+		OnComplete(FHttpServerResponse::Create(FormatMetrics(), TEXT("text/plain; version=0.0.4; charset=utf-8")));
+		return true;
+	}
+
+	void Startup()
+	{
+		if (Server.Router)
+		{
+			return;
+		}
+
+		uint32 Port = 0;
+		if (!FParse::Value(FCommandLine::Get(), TEXT("CH8MetricsPort="), Port) || Port == 0)
+		{
+			return;
+		}
+
+		// 바인드 주소는 DefaultEngine.ini 의 [HTTPServer.Listeners] DefaultBindAddress (127.0.0.1)
+		Server.Router = FHttpServerModule::Get().GetHttpRouter(Port, true);
+		if (!Server.Router)
+		{
+			UE_LOG(LogGameplayMetrics, Warning, TEXT("Metrics endpoint could not bind port %u"), Port);
+			return;
+		}
+
+		Server.RouteHandle = Server.Router->BindRoute(FHttpPath(TEXT("/metrics")), EHttpServerRequestVerbs::VERB_GET,
+			FHttpRequestHandler::CreateStatic(&HandleMetricsRequest));
+		FHttpServerModule::Get().StartAllListeners();
+		Server.EndFrameHandle = FCoreDelegates::OnEndFrame.AddStatic(&OnEndFrame);
+		Server.Port = Port;
+
+		UE_LOG(LogGameplayMetrics, Log, TEXT("Metrics endpoint listening on http://localhost:%u/metrics"), Port);
+	}
+
+	void Shutdown()
+	{
+		if (!Server.Router)
+		{
+			return;
+		}
+
+		FCoreDelegates::OnEndFrame.Remove(Server.EndFrameHandle);
+		Server.Router->UnbindRoute(Server.RouteHandle);
+		Server.Router.Reset();
+		Server.Port = 0;
+	}
+
+	bool IsEnabled()
+	{
+		return Server.Router.IsValid();
+	}
+
+	void SetLevelAndWave(int32 LevelIndex, int32 WaveIndex)
+	{
+		Counters.LevelIndex.store(LevelIndex, std::memory_order_relaxed);
+		Counters.WaveIndex.store(WaveIndex, std::memory_order_relaxed);
+	}
+
+	void SetTotalScore(int32 TotalScore)
+	{
+		Counters.TotalScore.store(TotalScore, std::memory_order_relaxed);
+	}
+
+	void RecordWaveSpawnTime(int32 WaveIndex, double Milliseconds)
+	{
+		Counters.LastSpawnMs[FMath::Clamp(WaveIndex, 0, MaxWaves - 1)].store(Milliseconds, std::memory_order_relaxed);
+		AtomicAdd(Counters.SpawnSumMs, Milliseconds);
+		Counters.SpawnCount.fetch_add(1, std::memory_order_relaxed);
+	}
+
+	void RecordWaveClearTime(int32 WaveIndex, double Milliseconds)
+	{
+		Counters.LastClearMs[FMath::Clamp(WaveIndex, 0, MaxWaves - 1)].store(Milliseconds, std::memory_order_relaxed);
+		AtomicAdd(Counters.ClearSumMs, Milliseconds);
+		Counters.ClearCount.fetch_add(1, std::memory_order_relaxed);
+	}
+
+	void RecordPickup()
+	{
+		Counters.Pickups.fetch_add(1, std::memory_order_relaxed);
+	}
+
+	void RecordDamage(float Amount)
+	{
+		Counters.DamageEvents.fetch_add(1, std::memory_order_relaxed);
+		AtomicAdd(Counters.DamageTotal, static_cast<double>(Amount));
+	}
+
+	void AddLiveItem(uint16 TypeId, FName ItemType, int32 Delta)
+	{
+		const int32 Slot = TypeId < MaxItemTypes ? TypeId : 0;
+		if (Slot != 0 && IsInGameThread())
+		{
+			Server.ItemTypeNames[Slot] = ItemType;
+		}
+		Counters.LiveItems[Slot].fetch_add(Delta, std::memory_order_relaxed);
+	}
+}
+
+#endif
@@ -0,0 +1,81 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "GameplaySchedulerSubsystem.h"
+#include "Engine/World.h"
+
+DECLARE_CYCLE_STAT(TEXT("Gameplay Scheduler Dispatch"), STAT_GameplaySchedulerDispatch, STATGROUP_Game);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Gameplay Timers Pending"), STAT_GameplayTimersPending, STATGROUP_Game);
+
+UGameplaySchedulerSubsystem::UGameplaySchedulerSubsystem()
+	// 1/60초 해상도, 약 17초 한 바퀴. 더 먼 마감은 같은 슬롯에서 다음 바퀴를 기다림
+	: Wheel(1.0 / 60.0, 1024)
+{
+}
+
+bool UGameplaySchedulerSubsystem::ShouldCreateSubsystem(UObject* Outer) const
+{
+	const UWorld* World = Cast<UWorld>(Outer);
+	return World && World->IsGameWorld();
+}
+
+void UGameplaySchedulerSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	Wheel.Reset(0.0);
+}
+
+TStatId UGameplaySchedulerSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UGameplaySchedulerSubsystem, STATGROUP_Tickables);
+}
+
+void UGameplaySchedulerSubsystem::SetHandler(EGameplayTimerKind Kind, FGameplayTimerBatchHandler&& Handler)
+{
+	Handlers[static_cast<int32>(Kind)] = MoveTemp(Handler);
+}
+
+FGameplayTimerHandle UGameplaySchedulerSubsystem::Schedule(float Delay, EGameplayTimerKind Kind, UObject* Target, uint32 Payload)
+{
+	return Wheel.Schedule(GetWorld()->GetTimeSeconds() + FMath::Max(Delay, 0.0f), static_cast<uint8>(Kind), Target, Payload);
+}
+
+float UGameplaySchedulerSubsystem::GetRemaining(const FGameplayTimerHandle& Handle) const
+{
+	const double DueTime = Wheel.GetDueTime(Handle);
+	return DueTime < 0.0 ? 0.0f : FMath::Max(static_cast<float>(DueTime - GetWorld()->GetTimeSeconds()), 0.0f);
+}
+
+void UGameplaySchedulerSubsystem::Tick(float DeltaTime)
+{
+	SCOPE_CYCLE_COUNTER(STAT_GameplaySchedulerDispatch);
+
+	DueTimers.Reset();
+	Wheel.Advance(GetWorld()->GetTimeSeconds(), DueTimers);
+	SET_DWORD_STAT(STAT_GameplayTimersPending, Wheel.Num());
+
+	if (DueTimers.IsEmpty())
+	{
+		return;
+	}
+
+	for (const FGameplayTimingWheel::FDueTimer& Due : DueTimers)
+	{
+		Batches[Due.Kind].Add(Due.Event);
+	}
+
+	// 처리기 안에서 새로 예약한 항목은 다음 프레임 이후에 실행됨
+	for (int32 KindIndex = 0; KindIndex < static_cast<int32>(EGameplayTimerKind::Num); KindIndex++)
+	{
+		if (Batches[KindIndex].IsEmpty())
+		{
+			continue;
+		}
+		if (Handlers[KindIndex])
+		{
+			Handlers[KindIndex](Batches[KindIndex]);
+		}
+		Batches[KindIndex].Reset();
+	}
+}
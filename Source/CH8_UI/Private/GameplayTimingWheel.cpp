@@ -0,0 +1,167 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "GameplayTimingWheel.h"
+
+FGameplayTimingWheel::FGameplayTimingWheel(double InResolution, int32 InNumSlots)
+	: Resolution(FMath::Max(InResolution, UE_DOUBLE_SMALL_NUMBER))
+{
+	SlotHeads.Init(InvalidIndex, FMath::Max(InNumSlots, 1));
+}
+
+void FGameplayTimingWheel::Reset(double StartTime)
+{
+	Entries.Reset();
+	FreeIndices.Reset();
+	SlotHeads.Init(InvalidIndex, SlotHeads.Num());
+	CurrentTick = FMath::FloorToInt64(StartTime / Resolution);
+	NumPending = 0;
+}
+
+int64 FGameplayTimingWheel::TimeToTick(double Time) const
+{
+	// 올림: 틱 T 를 처리할 때 Now >= T * Resolution >= DueTime 이 보장됨
+	return FMath::CeilToInt64(Time / Resolution);
+}
+
+FGameplayTimerHandle FGameplayTimingWheel::Schedule(double DueTime, uint8 Kind, UObject* Target, uint32 Payload)
+{
+	uint32 Index;
+	if (FreeIndices.Num() > 0)
+	{
+		Index = FreeIndices.Pop(EAllowShrinking::No);
+	}
+	else
+	{
+		Index = Entries.AddDefaulted();
+	}
+
+	FEntry& Entry = Entries[Index];
+	Entry.DueTime = DueTime;
+	// 이미 지난 시각이면 다음 틱에 실행
+	Entry.DueTick = FMath::Max(TimeToTick(DueTime), CurrentTick + 1);
+	Entry.Target = Target;
+	Entry.Payload = Payload;
+	Entry.Kind = Kind;
+	Entry.bPending = true;
+	Link(Index);
+	NumPending++;
+
+	FGameplayTimerHandle Handle;
+	Handle.Index = Index;
+	Handle.Generation = Entry.Generation;
+	return Handle;
+}
+
+void FGameplayTimingWheel::Link(uint32 Index)
+{
+	FEntry& Entry = Entries[Index];
+	uint32& Head = SlotHeads[Entry.DueTick % SlotHeads.Num()];
+	Entry.Prev = InvalidIndex;
+	Entry.Next = Head;
+	if (Head != InvalidIndex)
+	{
+		Entries[Head].Prev = Index;
+	}
+	Head = Index;
+}
+
+void FGameplayTimingWheel::Unlink(uint32 Index)
+{
+	FEntry& Entry = Entries[Index];
+	if (Entry.Prev != InvalidIndex)
+	{
+		Entries[Entry.Prev].Next = Entry.Next;
+	}
+	else
+	{
+		SlotHeads[Entry.DueTick % SlotHeads.Num()] = Entry.Next;
+	}
+	if (Entry.Next != InvalidIndex)
+	{
+		Entries[Entry.Next].Prev = Entry.Prev;
+	}
+	Entry.Prev = InvalidIndex;
+	Entry.Next = InvalidIndex;
+}
+
+void FGameplayTimingWheel::Release(uint32 Index)
+{
+	FEntry& Entry = Entries[Index];
+	Entry.bPending = false;
+	Entry.Generation++;
+	Entry.Target.Reset();
+	FreeIndices.Add(Index);
+	NumPending--;
+}
+
+const FGameplayTimingWheel::FEntry* FGameplayTimingWheel::FindPending(const FGameplayTimerHandle& Handle) const
+{
+	if (!Entries.IsValidIndex(Handle.Index))
+	{
+		return nullptr;
+	}
+	const FEntry& Entry = Entries[Handle.Index];
+	return Entry.bPending && Entry.Generation == Handle.Generation ? &Entry : nullptr;
+}
+
+bool FGameplayTimingWheel::Cancel(FGameplayTimerHandle& Handle, uint32* OutPayload)
+{
+	const bool bPending = FindPending(Handle) != nullptr;
+	if (bPending)
+	{
+		if (OutPayload)
+		{
+			*OutPayload = Entries[Handle.Index].Payload;
+		}
+		Unlink(Handle.Index);
+		Release(Handle.Index);
+	}
+	Handle.Invalidate();
+	return bPending;
+}
+
+bool FGameplayTimingWheel::IsPending(const FGameplayTimerHandle& Handle) const
+{
+	return FindPending(Handle) != nullptr;
+}
+
+double FGameplayTimingWheel::GetDueTime(const FGameplayTimerHandle& Handle) const
+{
+	const FEntry* Entry = FindPending(Handle);
+	return Entry ? Entry->DueTime : -1.0;
+}
+
+void FGameplayTimingWheel::Advance(double Now, TArray<FDueTimer>& OutDue)
+{
+	const int64 TargetTick = FMath::FloorToInt64(Now / Resolution);
+	if (TargetTick <= CurrentTick)
+	{
+		return;
+	}
+
+	// 한 바퀴 넘게 밀렸으면 모든 슬롯을 한 번씩만 훑으면 충분
+	const int64 FirstTick = FMath::Max(CurrentTick + 1, TargetTick - SlotHeads.Num() + 1);
+	for (int64 Tick = FirstTick; Tick <= TargetTick && NumPending > 0; Tick++)
+	{
+		uint32 Index = SlotHeads[Tick % SlotHeads.Num()];
+		while (Index != InvalidIndex)
+		{
+			FEntry& Entry = Entries[Index];
+			const uint32 NextIndex = Entry.Next;
+			// 같은 슬롯에는 몇 바퀴 뒤의 항목도 섞여 있음
+			if (Entry.DueTick <= TargetTick)
+			{
+				FDueTimer& Due = OutDue.AddDefaulted_GetRef();
+				Due.Kind = Entry.Kind;
+				Due.Event.Target = Entry.Target;
+				Due.Event.Payload = Entry.Payload;
+				Unlink(Index);
+				Release(Index);
+			}
+			Index = NextIndex;
+		}
+	}
+
+	CurrentTick = TargetTick;
+}
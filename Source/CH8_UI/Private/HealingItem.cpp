@@ -1,5 +1,4 @@
 #include "HealingItem.h"
-#include "CH8_UI/CH8_UICharacter.h"
 
 AHealingItem::AHealingItem()
 {
@@ -7,16 +6,9 @@ AHealingItem::AHealingItem()
 	ItemType = "Healing";
 }
 
-void AHealingItem::ActivateItem(AActor* Activator)
+void AHealingItem::DescribeEffect(FItemEffectRow& OutEffect) const
 {
-	if (Activator && Activator->ActorHasTag("Player"))
-	{
-		if (ACH8_UICharacter* PlayerCharacter = Cast<ACH8_UICharacter>(Activator))
-		{
-			// 캐릭터의 체력을 회복
-			PlayerCharacter->AddHealth(HealAmount);
-		}
-			
-		DestroyItem();
-	}
+	// 획득한 캐릭터의 체력을 회복
+	OutEffect.EffectType = EItemEffectType::Heal;
+	OutEffect.Magnitude = HealAmount;
 }
\ No newline at end of file
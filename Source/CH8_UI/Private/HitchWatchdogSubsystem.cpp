@@ -0,0 +1,207 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "HitchWatchdogSubsystem.h"
+#include "BaseGameState.h"
+#include "BaseItem.h"
+#include "GameplayEventSubsystem.h"
+#include "ItemEffectSubsystem.h"
+#include "SpawnRecordSubsystem.h"
+#include "Engine/GameInstance.h"
+#include "Engine/World.h"
+#include "EngineUtils.h"
+#include "Misc/CommandLine.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "ProfilingDebugging/TraceAuxiliary.h"
+#include "RenderCore.h"
+#include "UObject/UObjectGlobals.h"
+
+DEFINE_LOG_CATEGORY(LogHitchWatchdog);
+
+bool UHitchWatchdogSubsystem::ShouldCreateSubsystem(UObject* Outer) const
+{
+	return !FParse::Param(FCommandLine::Get(), TEXT("NoHitchWatchdog"));
+}
+
+void UHitchWatchdogSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	PreLoadMapHandle = FCoreUObjectDelegates::PreLoadMap.AddUObject(this, &UHitchWatchdogSubsystem::OnPreLoadMap);
+	PostLoadMapHandle = FCoreUObjectDelegates::PostLoadMapWithWorld.AddUObject(this, &UHitchWatchdogSubsystem::OnPostLoadMap);
+}
+
+void UHitchWatchdogSubsystem::Deinitialize()
+{
+	FCoreUObjectDelegates::PreLoadMap.Remove(PreLoadMapHandle);
+	FCoreUObjectDelegates::PostLoadMapWithWorld.Remove(PostLoadMapHandle);
+
+	Super::Deinitialize();
+}
+
+ETickableTickType UHitchWatchdogSubsystem::GetTickableTickType() const
+{
+	return HasAnyFlags(RF_ClassDefaultObject) ? ETickableTickType::Never : ETickableTickType::Always;
+}
+
+TStatId UHitchWatchdogSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UHitchWatchdogSubsystem, STATGROUP_Tickables);
+}
+
+void UHitchWatchdogSubsystem::OnPreLoadMap(const FString& MapName)
+{
+	bLoadingMap = true;
+}
+
+void UHitchWatchdogSubsystem::OnPostLoadMap(UWorld* LoadedWorld)
+{
+	bLoadingMap = false;
+	IgnoreFrames = FramesToIgnoreAfterMapLoad;
+}
+
+void UHitchWatchdogSubsystem::Tick(float DeltaTime)
+{
+	if (!bEnabled)
+	{
+		return;
+	}
+
+	const double Now = FPlatformTime::Seconds();
+	if (PendingSnapshot.IsSet() && Now >= PendingSnapshot->WriteTime)
+	{
+		WriteSnapshot(PendingSnapshot.GetValue());
+		PendingSnapshot.Reset();
+	}
+
+	if (bLoadingMap || IgnoreFrames > 0)
+	{
+		IgnoreFrames = FMath::Max(IgnoreFrames - 1, 0);
+		return;
+	}
+
+	// 직전 프레임의 게임 스레드 작업 시간 (대기 시간 제외)
+	const float FrameMs = FPlatformTime::ToMilliseconds(GGameThreadTime);
+	if (FrameMs <= HitchThresholdMs)
+	{
+		return;
+	}
+
+	if (PendingSnapshot.IsSet() || SnapshotCount >= MaxSnapshotsPerSession || Now - LastSnapshotTime < MinSecondsBetweenSnapshots)
+	{
+		SuppressedHitches++;
+		return;
+	}
+
+	CaptureHitch(FrameMs);
+}
+
+void UHitchWatchdogSubsystem::CaptureHitch(float FrameMs)
+{
+	const double Now = FPlatformTime::Seconds();
+	LastSnapshotTime = Now;
+	SnapshotCount++;
+
+	FPendingSnapshot& Snapshot = PendingSnapshot.Emplace();
+	Snapshot.HitchTime = Now;
+	Snapshot.WriteTime = Now + PostHitchSeconds;
+	Snapshot.FrameMs = FrameMs;
+
+	// 레벨/웨이브와 아이템 수는 히치 직후의 값
+	if (UWorld* World = GetGameInstance()->GetWorld())
+	{
+		Snapshot.MapName = World->GetMapName();
+
+		if (const ABaseGameState* GameState = World->GetGameState<ABaseGameState>())
+		{
+			Snapshot.LevelIndex = GameState->CurrentLevelIndex;
+			Snapshot.WaveIndex = GameState->CurrentWave;
+			Snapshot.CollectedCoins = GameState->CollectedCoinCount;
+			Snapshot.SpawnedCoins = GameState->SpawnedCoinCount;
+		}
+
+		const UItemEffectSubsystem* EffectSubsystem = World->GetSubsystem<UItemEffectSubsystem>();
+		for (TActorIterator<ABaseItem> It(World); It; ++It)
+		{
+			const FName TypeName = EffectSubsystem ? EffectSubsystem->GetItemTypeName(It->GetItemTypeId()) : NAME_None;
+			TPair<FName, int32>* Count = Snapshot.ItemCounts.FindByPredicate([TypeName](const TPair<FName, int32>& Pair) { return Pair.Key == TypeName; });
+			if (Count)
+			{
+				Count->Value++;
+			}
+			else
+			{
+				Snapshot.ItemCounts.Emplace(TypeName, 1);
+			}
+		}
+
+		if (const USpawnRecordSubsystem* SpawnRecords = World->GetSubsystem<USpawnRecordSubsystem>())
+		{
+			Snapshot.DeferredItems = SpawnRecords->GetNumPending();
+		}
+	}
+
+	UE_LOG(LogHitchWatchdog, Warning, TEXT("Hitch %.1f ms (threshold %.1f ms) on %s level %d wave %d, snapshot in %.1fs"),
+		FrameMs, HitchThresholdMs, *Snapshot.MapName, Snapshot.LevelIndex + 1, Snapshot.WaveIndex + 1, PostHitchSeconds);
+}
+
+void UHitchWatchdogSubsystem::WriteSnapshot(const FPendingSnapshot& Snapshot)
+{
+	const FString BasePath = FPaths::ProjectSavedDir() / TEXT("Hitches")
+		/ FString::Printf(TEXT("Hitch-%s-%.0fms"), *FDateTime::Now().ToString(), Snapshot.FrameMs);
+
+	FString TraceResult = TEXT("disabled");
+#if UE_TRACE_ENABLED
+	if (bCaptureTrace)
+	{
+		// 테일 버퍼에 남아있는 최근 트레이스(히치 전후)를 파일로 저장. 버퍼 크기는 -tracetailmb 로 조절
+		const FString TracePath = BasePath + TEXT(".utrace");
+		TraceResult = FTraceAuxiliary::WriteSnapshot(*TracePath) ? FPaths::GetCleanFilename(TracePath) : TEXT("failed");
+	}
+#endif
+
+	TArray<FString> Lines;
+	Lines.Add(FString::Printf(TEXT("FrameMs=%.2f"), Snapshot.FrameMs));
+	Lines.Add(FString::Printf(TEXT("ThresholdMs=%.2f"), HitchThresholdMs));
+	Lines.Add(FString::Printf(TEXT("Map=%s"), *Snapshot.MapName));
+	Lines.Add(FString::Printf(TEXT("Level=%d"), Snapshot.LevelIndex + 1));
+	Lines.Add(FString::Printf(TEXT("Wave=%d"), Snapshot.WaveIndex + 1));
+	Lines.Add(FString::Printf(TEXT("Coins=%d/%d"), Snapshot.CollectedCoins, Snapshot.SpawnedCoins));
+	Lines.Add(FString::Printf(TEXT("DeferredItems=%d"), Snapshot.DeferredItems));
+	Lines.Add(FString::Printf(TEXT("SuppressedHitches=%d"), SuppressedHitches));
+	Lines.Add(FString::Printf(TEXT("Trace=%s"), *TraceResult));
+
+	Lines.Add(TEXT(""));
+	Lines.Add(TEXT("ItemType,Count"));
+	for (const TPair<FName, int32>& Pair : Snapshot.ItemCounts)
+	{
+		Lines.Add(FString::Printf(TEXT("%s,%d"), *Pair.Key.ToString(), Pair.Value));
+	}
+
+	// 시간은 히치 기준 상대값 (음수 = 히치 이전)
+	Lines.Add(TEXT(""));
+	Lines.Add(TEXT("RelativeTime,Type,Name,A,B,Value"));
+	if (const UGameplayEventSubsystem* EventSubsystem = GetGameInstance()->GetSubsystem<UGameplayEventSubsystem>())
+	{
+		TArray<FRecentGameplayEvent> Events;
+		EventSubsystem->GetRecentEvents(Events);
+		for (const FRecentGameplayEvent& Event : Events)
+		{
+			Lines.Add(FString::Printf(TEXT("%.3f,%s,%s,%d,%d,%g"),
+				Event.Time - Snapshot.HitchTime, LexToString(Event.Type), Event.Name.IsNone() ? TEXT("") : *Event.Name.ToString(), Event.A, Event.B, Event.Value));
+		}
+	}
+
+	const FString ReportPath = BasePath + TEXT(".txt");
+	if (FFileHelper::SaveStringArrayToFile(Lines, *ReportPath))
+	{
+		UE_LOG(LogHitchWatchdog, Warning, TEXT("Hitch snapshot written to %s (trace: %s)"), *ReportPath, *TraceResult);
+	}
+	else
+	{
+		UE_LOG(LogHitchWatchdog, Error, TEXT("Failed to write hitch snapshot %s"), *ReportPath);
+	}
+
+	SuppressedHitches = 0;
+}
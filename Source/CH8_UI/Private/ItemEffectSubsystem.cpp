@@ -0,0 +1,392 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "ItemEffectSubsystem.h"
+#include "BaseGameState.h"
+#include "BaseItem.h"
+#include "CoinSpatialIndexSubsystem.h"
+#include "FloatingTextSubsystem.h"
+#include "GameplaySchedulerSubsystem.h"
+#include "GameplayEventSubsystem.h"
+#include "GameplayAllocCheck.h"
+#include "RivalCollectorsActor.h"
+#include "StatusEffectSubsystem.h"
+#include "CH8_UI/CH8_UICharacter.h"
+#include "Engine/World.h"
+#include "GameFramework/DamageType.h"
+#include "GameFramework/PlayerController.h"
+#include "Kismet/GameplayStatics.h"
+
+bool UItemEffectSubsystem::ShouldCreateSubsystem(UObject* Outer) const
+{
+	const UWorld* World = Cast<UWorld>(Outer);
+	return World && World->IsGameWorld();
+}
+
+void UItemEffectSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	TypeNames.Add(NAME_None);
+	Effects.AddDefaulted();
+
+	UGameplaySchedulerSubsystem* Scheduler = Collection.InitializeDependency<UGameplaySchedulerSubsystem>();
+	if (Scheduler)
+	{
+		Scheduler->SetHandler(EGameplayTimerKind::ItemEffect, [this](TConstArrayView<FGameplayTimerEvent> Events) { OnDelayedEffectsDue(Events); });
+		Scheduler->SetHandler(EGameplayTimerKind::ItemExpiry, [this](TConstArrayView<FGameplayTimerEvent> Events) { OnItemsExpired(Events); });
+	}
+
+	if (!ItemEffectTable.IsNull())
+	{
+		LoadedEffectTable = ItemEffectTable.LoadSynchronous();
+	}
+}
+
+TStatId UItemEffectSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UItemEffectSubsystem, STATGROUP_Tickables);
+}
+
+FItemTypeId UItemEffectSubsystem::RegisterItemType(FName ItemType, const ABaseItem& Prototype)
+{
+	if (ItemType.IsNone())
+	{
+		return InvalidItemTypeId;
+	}
+
+	if (const FItemTypeId* ExistingId = TypeIds.Find(ItemType))
+	{
+		return *ExistingId;
+	}
+
+	if (TypeNames.Num() > MAX_uint16)
+	{
+		return InvalidItemTypeId;
+	}
+
+	FItemEffectRow Effect;
+	Prototype.DescribeEffect(Effect);
+
+	if (LoadedEffectTable)
+	{
+		static const FString ContextString(TEXT("ItemEffectContext"));
+		if (const FItemEffectRow* TableRow = LoadedEffectTable->FindRow<FItemEffectRow>(ItemType, ContextString, false))
+		{
+			Effect = *TableRow;
+		}
+	}
+
+	const FItemTypeId NewId = static_cast<FItemTypeId>(TypeNames.Num());
+	TypeNames.Add(ItemType);
+	Effects.Add(Effect);
+	TypeIds.Add(ItemType, NewId);
+	return NewId;
+}
+
+FItemTypeId UItemEffectSubsystem::FindItemTypeId(FName ItemType) const
+{
+	const FItemTypeId* TypeId = TypeIds.Find(ItemType);
+	return TypeId ? *TypeId : InvalidItemTypeId;
+}
+
+const FItemEffectRow* UItemEffectSubsystem::GetEffect(FItemTypeId TypeId) const
+{
+	return TypeId != InvalidItemTypeId && Effects.IsValidIndex(TypeId) ? &Effects[TypeId] : nullptr;
+}
+
+FName UItemEffectSubsystem::GetItemTypeName(FItemTypeId TypeId) const
+{
+	return TypeNames.IsValidIndex(TypeId) ? TypeNames[TypeId] : NAME_None;
+}
+
+bool UItemEffectSubsystem::CountsAsCoin(const AActor* Actor) const
+{
+	const ABaseItem* Item = Cast<ABaseItem>(Actor);
+	const FItemEffectRow* Effect = Item ? GetEffect(Item->GetItemTypeId()) : nullptr;
+	return Effect && Effect->bCountsAsCoin;
+}
+
+bool UItemEffectSubsystem::CountsAsCoin(TSubclassOf<AActor> ItemClass)
+{
+	const ABaseItem* Prototype = ItemClass ? Cast<ABaseItem>(ItemClass->GetDefaultObject()) : nullptr;
+	if (!Prototype)
+	{
+		return false;
+	}
+
+	const FItemEffectRow* Effect = GetEffect(RegisterItemType(static_cast<const IItemInterface*>(Prototype)->GetItemType(), *Prototype));
+	return Effect && Effect->bCountsAsCoin;
+}
+
+bool UItemEffectSubsystem::ResolveEffect(const ABaseItem& Item, FItemEffectRow& OutEffect) const
+{
+	const FItemEffectRow* Effect = GetEffect(Item.GetItemTypeId());
+	if (!Effect)
+	{
+		return false;
+	}
+
+	OutEffect = *Effect;
+	Item.GetEffectOverrides().ApplyTo(OutEffect);
+	return true;
+}
+
+FGameplayTimerHandle UItemEffectSubsystem::QueueEffect(FItemTypeId TypeId, const FItemEffectOverrides& Overrides, AActor* Activator, ABaseItem* SourceItem)
+{
+	const FItemEffectRow* Effect = GetEffect(TypeId);
+	if (!Effect)
+	{
+		return FGameplayTimerHandle();
+	}
+
+	FQueuedItemEffect Entry;
+	Entry.TypeId = TypeId;
+	Entry.Overrides = Overrides;
+	Entry.Activator = Activator;
+	Entry.SourceItem = SourceItem;
+	Entry.Location = SourceItem ? SourceItem->GetActorLocation() : FVector::ZeroVector;
+
+	UGameplaySchedulerSubsystem* Scheduler = GetWorld()->GetSubsystem<UGameplaySchedulerSubsystem>();
+	if (Effect->Delay > 0.0f && Scheduler)
+	{
+		const int32 DelayedIndex = DelayedEffects.Add(Entry);
+		return Scheduler->Schedule(Effect->Delay, EGameplayTimerKind::ItemEffect, SourceItem, DelayedIndex);
+	}
+
+	ReadyEffects.Add(Entry);
+	return FGameplayTimerHandle();
+}
+
+void UItemEffectSubsystem::CancelEffect(FGameplayTimerHandle& Handle)
+{
+	UGameplaySchedulerSubsystem* Scheduler = GetWorld()->GetSubsystem<UGameplaySchedulerSubsystem>();
+	uint32 DelayedIndex = 0;
+	if (Scheduler && Scheduler->Cancel(Handle, &DelayedIndex) && DelayedEffects.IsValidIndex(DelayedIndex))
+	{
+		DelayedEffects.RemoveAt(DelayedIndex);
+	}
+	Handle.Invalidate();
+}
+
+FGameplayTimerHandle UItemEffectSubsystem::ScheduleExpiry(ABaseItem* Item, float Lifetime)
+{
+	UGameplaySchedulerSubsystem* Scheduler = GetWorld()->GetSubsystem<UGameplaySchedulerSubsystem>();
+	return Scheduler && Lifetime > 0.0f ? Scheduler->Schedule(Lifetime, EGameplayTimerKind::ItemExpiry, Item) : FGameplayTimerHandle();
+}
+
+void UItemEffectSubsystem::CancelExpiry(FGameplayTimerHandle& Handle)
+{
+	if (UGameplaySchedulerSubsystem* Scheduler = GetWorld()->GetSubsystem<UGameplaySchedulerSubsystem>())
+	{
+		Scheduler->Cancel(Handle);
+	}
+	Handle.Invalidate();
+}
+
+void UItemEffectSubsystem::OnDelayedEffectsDue(TConstArrayView<FGameplayTimerEvent> Events)
+{
+	for (const FGameplayTimerEvent& Event : Events)
+	{
+		if (DelayedEffects.IsValidIndex(Event.Payload))
+		{
+			ReadyEffects.Add(DelayedEffects[Event.Payload]);
+			DelayedEffects.RemoveAt(Event.Payload);
+		}
+	}
+}
+
+void UItemEffectSubsystem::OnItemsExpired(TConstArrayView<FGameplayTimerEvent> Events)
+{
+	int32 ExpiredCoins = 0;
+	for (const FGameplayTimerEvent& Event : Events)
+	{
+		ABaseItem* Item = Cast<ABaseItem>(Event.Target.Get());
+		if (!Item || Item->IsEffectPending())
+		{
+			continue;
+		}
+
+		if (CountsAsCoin(Item))
+		{
+			ExpiredCoins++;
+		}
+		Item->DestroyItem();
+	}
+
+	// 사라진 코인은 웨이브 완료 조건에서 빠짐
+	if (ExpiredCoins > 0)
+	{
+		if (ABaseGameState* GameState = GetWorld()->GetGameState<ABaseGameState>())
+		{
+			GameState->OnCoinsExpired(ExpiredCoins);
+		}
+	}
+}
+
+void UItemEffectSubsystem::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	ProcessEffects();
+}
+
+void UItemEffectSubsystem::ProcessEffects()
+{
+	if (ReadyEffects.IsEmpty())
+	{
+		return;
+	}
+
+	// 처리 도중 새로 들어온 효과는 다음 프레임에 처리
+	Swap(ProcessingEffects, ReadyEffects);
+
+	int32 ScoreTotal = 0;
+	int32 CoinsCollected = 0;
+	TArray<TPair<ACH8_UICharacter*, float>, TInlineAllocator<4>> Heals;
+
+	UCoinSpatialIndexSubsystem* SpatialIndex = GetWorld()->GetSubsystem<UCoinSpatialIndexSubsystem>();
+	UFloatingTextSubsystem* FloatingText = GetWorld()->GetSubsystem<UFloatingTextSubsystem>();
+	UStatusEffectSubsystem* StatusEffects = GetWorld()->GetSubsystem<UStatusEffectSubsystem>();
+
+	// 웨이브/레벨 전환을 일으킬 수 있는 아래의 GameState 호출은 획득 경로에 포함하지 않음
+	{
+		CH8_ALLOC_SCOPE(Pickup);
+		for (const FQueuedItemEffect& Entry : ProcessingEffects)
+		{
+			FItemEffectRow Effect = Effects[Entry.TypeId];
+			Entry.Overrides.ApplyTo(Effect);
+
+			// 남아있어야 할 아이템이 그 사이 웨이브 정리 등으로 사라졌으면 효과도 취소
+			if (!Effect.bDestroyOnActivate && !Entry.SourceItem.IsValid())
+			{
+				continue;
+			}
+
+			switch (Effect.EffectType)
+			{
+			case EItemEffectType::Score:
+			{
+				// 라이벌이 가져간 코인은 코인 집계에만 반영되고 점수는 URivalCollectorSubsystem 쪽에 쌓임
+				const AActor* Activator = Entry.Activator.Get();
+				if (Activator && Activator->ActorHasTag(ARivalCollectorsActor::RivalTag))
+				{
+					break;
+				}
+
+				// 점수 배율 효과가 있으면 획득한 플레이어 기준으로 곱함
+				const float ScoreMultiplier = StatusEffects ? StatusEffects->GetScoreMultiplier(Entry.Activator.Get()) : 1.0f;
+				const int32 Points = FMath::RoundToInt(Effect.Magnitude * ScoreMultiplier);
+				ScoreTotal += Points;
+				if (FloatingText)
+				{
+					FloatingText->AddText(EFloatingTextKind::Score, Points, Entry.Location);
+				}
+				break;
+			}
+
+			case EItemEffectType::Heal:
+				if (ACH8_UICharacter* PlayerCharacter = Cast<ACH8_UICharacter>(Entry.Activator.Get()))
+				{
+					TPair<ACH8_UICharacter*, float>* Heal = Heals.FindByPredicate([PlayerCharacter](const TPair<ACH8_UICharacter*, float>& Pair) { return Pair.Key == PlayerCharacter; });
+					if (Heal)
+					{
+						Heal->Value += Effect.Magnitude;
+					}
+					else
+					{
+						Heals.Emplace(PlayerCharacter, Effect.Magnitude);
+					}
+				}
+				break;
+
+			case EItemEffectType::RadialDamage:
+				ApplyRadialDamage(Entry, Effect);
+				break;
+
+			case EItemEffectType::Magnet:
+				if (SpatialIndex)
+				{
+					SpatialIndex->StartAttraction(Entry.Activator.Get(), Effect.Radius, Effect.Duration, Effect.Magnitude);
+				}
+				break;
+
+			case EItemEffectType::Regeneration:
+			case EItemEffectType::SpeedBoost:
+			case EItemEffectType::ScoreMultiplier:
+			case EItemEffectType::Poison:
+				if (StatusEffects)
+				{
+					StatusEffects->AddEffect(Effect.EffectType, Cast<ACH8_UICharacter>(Entry.Activator.Get()), Effect.Magnitude, Effect.Duration);
+				}
+				break;
+
+			default:
+				break;
+			}
+
+			if (Effect.bCountsAsCoin)
+			{
+				CoinsCollected++;
+			}
+
+			// 효과가 끝날 때까지 남아있던 아이템 제거
+			if (!Effect.bDestroyOnActivate)
+			{
+				if (ABaseItem* SourceItem = Entry.SourceItem.Get())
+				{
+					SourceItem->DestroyItem();
+				}
+			}
+		}
+
+		ProcessingEffects.Reset();
+
+		for (const TPair<ACH8_UICharacter*, float>& Heal : Heals)
+		{
+			Heal.Key->AddHealth(Heal.Value);
+		}
+	}
+
+	// 코인 완료 처리는 웨이브/레벨 전환을 일으킬 수 있으므로 마지막에 한 번만
+	if (ABaseGameState* GameState = GetWorld()->GetGameState<ABaseGameState>())
+	{
+		if (ScoreTotal != 0)
+		{
+			GameState->AddScore(ScoreTotal);
+		}
+		if (CoinsCollected > 0)
+		{
+			GameState->OnCoinsCollected(CoinsCollected);
+		}
+	}
+}
+
+void UItemEffectSubsystem::ApplyRadialDamage(const FQueuedItemEffect& Entry, const FItemEffectRow& Effect)
+{
+	CH8_ALLOC_SCOPE(Detonation);
+
+	ABaseItem* SourceItem = Entry.SourceItem.Get();
+	const FVector Origin = SourceItem ? SourceItem->GetActorLocation() : Entry.Location;
+
+	int32 HitCount = 0;
+	for (FConstPlayerControllerIterator It = GetWorld()->GetPlayerControllerIterator(); It; ++It)
+	{
+		APawn* Pawn = It->IsValid() ? (*It)->GetPawn() : nullptr;
+		if (!Pawn || !Pawn->ActorHasTag("Player"))
+		{
+			continue;
+		}
+
+		// 예전 폭발 콜리전(구)과 캡슐이 겹치는 것과 같도록 캡슐 반경만큼 여유를 둠
+		const float HitRadius = Effect.Radius + Pawn->GetSimpleCollisionRadius();
+		if (FVector::DistSquared(Origin, Pawn->GetActorLocation()) <= FMath::Square(HitRadius))
+		{
+			// 데미지를 발생시켜 Actor->TakeDamage()가 실행되도록 함
+			UGameplayStatics::ApplyDamage(Pawn, Effect.Magnitude, nullptr, SourceItem, UDamageType::StaticClass());
+			HitCount++;
+		}
+	}
+
+	UGameplayEventSubsystem::Record(this, EGameplayEventType::Explode, FMath::RoundToInt(Effect.Magnitude), HitCount);
+}
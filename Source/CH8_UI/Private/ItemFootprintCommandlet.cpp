@@ -0,0 +1,277 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "ItemFootprintCommandlet.h"
+#include "BaseGameState.h"
+#include "ItemSpawnRow.h"
+#include "AssetRegistry/AssetData.h"
+#include "AssetRegistry/AssetRegistryModule.h"
+#include "AssetRegistry/IAssetRegistry.h"
+#include "Engine/Blueprint.h"
+#include "Engine/DataTable.h"
+#include "Engine/World.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/FileHelper.h"
+#include "Misc/PackageName.h"
+#include "Misc/Paths.h"
+#include "UObject/Package.h"
+#include "UObject/UObjectHash.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogItemFootprint, Log, All);
+
+namespace
+{
+	double ToMB(int64 Bytes)
+	{
+		return Bytes / (1024.0 * 1024.0);
+	}
+
+	bool IsOverBudget(int64 Bytes, float BudgetMB)
+	{
+		return BudgetMB > 0.0f && ToMB(Bytes) > BudgetMB;
+	}
+}
+
+UItemFootprintCommandlet::UItemFootprintCommandlet()
+{
+	IsClient = false;
+	IsServer = false;
+	IsEditor = true;
+	LogToConsole = true;
+}
+
+void UItemFootprintCommandlet::GatherClosure(const IAssetRegistry& AssetRegistry, FName RootPackage, TSet<FName>& OutPackages)
+{
+	TArray<FName> Stack;
+	Stack.Add(RootPackage);
+
+	TArray<FName> Dependencies;
+	while (!Stack.IsEmpty())
+	{
+		const FName PackageName = Stack.Pop(EAllowShrinking::No);
+		bool bAlreadyAdded = false;
+		OutPackages.Add(PackageName, &bAlreadyAdded);
+		if (bAlreadyAdded)
+		{
+			continue;
+		}
+
+		Dependencies.Reset();
+		AssetRegistry.GetDependencies(PackageName, Dependencies, UE::AssetRegistry::EDependencyCategory::Package, UE::AssetRegistry::EDependencyQuery::Hard);
+		for (const FName Dependency : Dependencies)
+		{
+			if (!FPackageName::IsScriptPackage(Dependency.ToString()) && !OutPackages.Contains(Dependency))
+			{
+				Stack.Add(Dependency);
+			}
+		}
+	}
+}
+
+const UItemFootprintCommandlet::FPackageFootprint& UItemFootprintCommandlet::GetPackageFootprint(const IAssetRegistry& AssetRegistry, FName PackageName)
+{
+	if (const FPackageFootprint* Cached = PackageFootprints.Find(PackageName))
+	{
+		return *Cached;
+	}
+
+	FPackageFootprint Footprint;
+	if (const TOptional<FAssetPackageData> PackageData = AssetRegistry.GetAssetPackageDataCopy(PackageName))
+	{
+		Footprint.DiskBytes = FMath::Max<int64>(PackageData->DiskSize, 0);
+	}
+
+	// 로드된 패키지의 오브젝트가 보고하는 리소스 크기 (텍스처는 모든 밉, 메시는 렌더 데이터 포함)
+	if (const UPackage* Package = FindPackage(nullptr, *PackageName.ToString()))
+	{
+		ForEachObjectWithPackage(Package, [&Footprint](UObject* Object)
+		{
+			Footprint.ResidentBytes += Object->GetResourceSizeBytes(EResourceSizeMode::EstimatedTotal);
+			return true;
+		});
+	}
+
+	return PackageFootprints.Add(PackageName, Footprint);
+}
+
+UItemFootprintCommandlet::FPackageFootprint UItemFootprintCommandlet::SumFootprint(const IAssetRegistry& AssetRegistry, const TSet<FName>& Packages)
+{
+	FPackageFootprint Total;
+	for (const FName PackageName : Packages)
+	{
+		const FPackageFootprint& Footprint = GetPackageFootprint(AssetRegistry, PackageName);
+		Total.DiskBytes += Footprint.DiskBytes;
+		Total.ResidentBytes += Footprint.ResidentBytes;
+	}
+	return Total;
+}
+
+FName UItemFootprintCommandlet::FindMapPackage(const IAssetRegistry& AssetRegistry, FName MapName)
+{
+	TArray<FAssetData> Maps;
+	AssetRegistry.GetAssetsByClass(UWorld::StaticClass()->GetClassPathName(), Maps);
+	for (const FAssetData& Map : Maps)
+	{
+		if (Map.AssetName == MapName)
+		{
+			return Map.PackageName;
+		}
+	}
+	return NAME_None;
+}
+
+int32 UItemFootprintCommandlet::Main(const FString& Params)
+{
+	FParse::Value(*Params, TEXT("MaxItemDiskMB="), MaxItemDiskMB);
+	FParse::Value(*Params, TEXT("MaxItemResidentMB="), MaxItemResidentMB);
+	FParse::Value(*Params, TEXT("MaxLevelResidentMB="), MaxLevelResidentMB);
+
+	if (LevelItemTables.IsEmpty())
+	{
+		UE_LOG(LogItemFootprint, Error, TEXT("No LevelItemTables configured in [/Script/CH8_UI.ItemFootprintCommandlet]"));
+		return 1;
+	}
+
+	const UClass* StateClass = GameStateClass.IsNull() ? ABaseGameState::StaticClass() : GameStateClass.LoadSynchronous();
+	const TArray<FName> LevelMapNames = StateClass ? StateClass->GetDefaultObject<ABaseGameState>()->LevelMapNames : TArray<FName>();
+
+	IAssetRegistry& AssetRegistry = FModuleManager::LoadModuleChecked<FAssetRegistryModule>(TEXT("AssetRegistry")).Get();
+	AssetRegistry.SearchAllAssets(true);
+
+	// 1) 테이블을 로드하기 전에 테이블이 직접 참조하는 블루프린트(아이템 클래스)를 하나씩 로드해 첫 로드 시간을 잰다.
+	//    여러 아이템이 함께 쓰는 에셋은 먼저 로드한 아이템의 시간에 들어감
+	TMap<FName, double> LoadMs;
+	for (const TSoftObjectPtr<UDataTable>& TablePtr : LevelItemTables)
+	{
+		const FName TablePackage = FName(*TablePtr.ToSoftObjectPath().GetLongPackageName());
+		TArray<FName> Dependencies;
+		AssetRegistry.GetDependencies(TablePackage, Dependencies, UE::AssetRegistry::EDependencyCategory::Package, UE::AssetRegistry::EDependencyQuery::Hard);
+
+		for (const FName Dependency : Dependencies)
+		{
+			TArray<FAssetData> Assets;
+			AssetRegistry.GetAssetsByPackageName(Dependency, Assets);
+			const bool bIsBlueprint = Assets.ContainsByPredicate([](const FAssetData& Asset)
+			{
+				return Asset.AssetClassPath == UBlueprint::StaticClass()->GetClassPathName();
+			});
+			if (!bIsBlueprint || LoadMs.Contains(Dependency) || FindPackage(nullptr, *Dependency.ToString()))
+			{
+				continue;
+			}
+
+			const double StartTime = FPlatformTime::Seconds();
+			LoadPackage(nullptr, *Dependency.ToString(), LOAD_None);
+			LoadMs.Add(Dependency, (FPlatformTime::Seconds() - StartTime) * 1000.0);
+		}
+	}
+
+	TArray<FString> Lines;
+	Lines.Add(TEXT("Level,Map,Item,Package,Packages,DiskMB,ResidentMB,FirstLoadMs,ItemOnlyDiskMB,OverBudget"));
+	int32 NumOverBudget = 0;
+
+	// 2) 레벨마다 아이템별, 레벨 합계 집계
+	for (int32 LevelIndex = 0; LevelIndex < LevelItemTables.Num(); LevelIndex++)
+	{
+		const UDataTable* SpawnTable = LevelItemTables[LevelIndex].LoadSynchronous();
+		if (!SpawnTable)
+		{
+			UE_LOG(LogItemFootprint, Error, TEXT("Spawn table %s is missing"), *LevelItemTables[LevelIndex].ToString());
+			return 1;
+		}
+
+		const FName MapName = LevelMapNames.IsValidIndex(LevelIndex) ? LevelMapNames[LevelIndex] : NAME_None;
+		const FName MapPackage = MapName.IsNone() ? NAME_None : FindMapPackage(AssetRegistry, MapName);
+		TSet<FName> MapClosure;
+		if (!MapPackage.IsNone())
+		{
+			GatherClosure(AssetRegistry, MapPackage, MapClosure);
+		}
+		else if (!MapName.IsNone())
+		{
+			UE_LOG(LogItemFootprint, Warning, TEXT("Level %d: map %s not found in the asset registry"), LevelIndex + 1, *MapName.ToString());
+		}
+
+		static const FString ContextString(TEXT("ItemFootprintContext"));
+		TArray<FItemSpawnRow*> Rows;
+		SpawnTable->GetAllRows(ContextString, Rows);
+
+		TSet<FName> LevelClosure;
+		TSet<FName> SeenItemPackages;
+		double LevelLoadMs = 0.0;
+
+		for (const FItemSpawnRow* Row : Rows)
+		{
+			if (!Row || !Row->ItemClass)
+			{
+				continue;
+			}
+
+			const FName ItemPackage = Row->ItemClass->GetPackage()->GetFName();
+			bool bAlreadySeen = false;
+			SeenItemPackages.Add(ItemPackage, &bAlreadySeen);
+			if (bAlreadySeen)
+			{
+				continue;
+			}
+
+			TSet<FName> ItemClosure;
+			GatherClosure(AssetRegistry, ItemPackage, ItemClosure);
+			LevelClosure.Append(ItemClosure);
+
+			const FPackageFootprint ItemFootprint = SumFootprint(AssetRegistry, ItemClosure);
+			const FPackageFootprint ItemOnlyFootprint = SumFootprint(AssetRegistry, ItemClosure.Difference(MapClosure));
+			const double ItemLoadMs = LoadMs.FindRef(ItemPackage);
+			LevelLoadMs += ItemLoadMs;
+
+			const bool bOverBudget = IsOverBudget(ItemFootprint.DiskBytes, MaxItemDiskMB) || IsOverBudget(ItemFootprint.ResidentBytes, MaxItemResidentMB);
+			NumOverBudget += bOverBudget ? 1 : 0;
+
+			Lines.Add(FString::Printf(TEXT("%d,%s,%s,%s,%d,%.3f,%.3f,%.2f,%.3f,%d"),
+				LevelIndex + 1, *MapName.ToString(), *Row->ItemName.ToString(), *ItemPackage.ToString(), ItemClosure.Num(),
+				ToMB(ItemFootprint.DiskBytes), ToMB(ItemFootprint.ResidentBytes), ItemLoadMs, ToMB(ItemOnlyFootprint.DiskBytes), bOverBudget ? 1 : 0));
+
+			UE_LOG(LogItemFootprint, Display, TEXT("Level %d %s: %d packages, disk %.2f MB, resident ~%.2f MB, first load %.1f ms"),
+				LevelIndex + 1, *Row->ItemName.ToString(), ItemClosure.Num(), ToMB(ItemFootprint.DiskBytes), ToMB(ItemFootprint.ResidentBytes), ItemLoadMs);
+			if (bOverBudget)
+			{
+				UE_LOG(LogItemFootprint, Error, TEXT("Level %d %s (%s) is over the item budget (disk %.2f / %.2f MB, resident %.2f / %.2f MB)"),
+					LevelIndex + 1, *Row->ItemName.ToString(), *ItemPackage.ToString(),
+					ToMB(ItemFootprint.DiskBytes), MaxItemDiskMB, ToMB(ItemFootprint.ResidentBytes), MaxItemResidentMB);
+			}
+		}
+
+		// 여러 아이템이 함께 쓰는 에셋은 레벨 합계에서 한 번만 셈
+		const FPackageFootprint LevelFootprint = SumFootprint(AssetRegistry, LevelClosure);
+		const FPackageFootprint LevelOnlyFootprint = SumFootprint(AssetRegistry, LevelClosure.Difference(MapClosure));
+		const bool bLevelOverBudget = IsOverBudget(LevelFootprint.ResidentBytes, MaxLevelResidentMB);
+		NumOverBudget += bLevelOverBudget ? 1 : 0;
+
+		Lines.Add(FString::Printf(TEXT("%d,%s,(all items),%s,%d,%.3f,%.3f,%.2f,%.3f,%d"),
+			LevelIndex + 1, *MapName.ToString(), *SpawnTable->GetPathName(), LevelClosure.Num(),
+			ToMB(LevelFootprint.DiskBytes), ToMB(LevelFootprint.ResidentBytes), LevelLoadMs, ToMB(LevelOnlyFootprint.DiskBytes), bLevelOverBudget ? 1 : 0));
+
+		UE_LOG(LogItemFootprint, Display, TEXT("Level %d (%s, %s): %d item packages, disk %.2f MB (%.2f MB not in the map), resident ~%.2f MB, load %.1f ms"),
+			LevelIndex + 1, *MapName.ToString(), *SpawnTable->GetName(), LevelClosure.Num(),
+			ToMB(LevelFootprint.DiskBytes), ToMB(LevelOnlyFootprint.DiskBytes), ToMB(LevelFootprint.ResidentBytes), LevelLoadMs);
+		if (bLevelOverBudget)
+		{
+			UE_LOG(LogItemFootprint, Error, TEXT("Level %d items are over the level budget (resident %.2f / %.2f MB)"),
+				LevelIndex + 1, ToMB(LevelFootprint.ResidentBytes), MaxLevelResidentMB);
+		}
+	}
+
+	FString OutPath;
+	if (!FParse::Value(*Params, TEXT("Out="), OutPath))
+	{
+		OutPath = FPaths::ProjectSavedDir() / TEXT("Footprint") / FString::Printf(TEXT("ItemFootprint-%s.csv"), *FDateTime::Now().ToString());
+	}
+	if (!FFileHelper::SaveStringArrayToFile(Lines, *OutPath))
+	{
+		UE_LOG(LogItemFootprint, Error, TEXT("Failed to write %s"), *OutPath);
+		return 1;
+	}
+
+	UE_LOG(LogItemFootprint, Display, TEXT("Wrote %s (%d over budget)"), *OutPath, NumOverBudget);
+	return NumOverBudget > 0 ? 1 : 0;
+}
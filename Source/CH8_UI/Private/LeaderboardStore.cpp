@@ -0,0 +1,350 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "LeaderboardStore.h"
+#include "Algo/BinarySearch.h"
+#include "Async/MappedFileHandle.h"
+#include "HAL/FileManager.h"
+#include "HAL/PlatformFileManager.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Misc/ScopeLock.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogLeaderboard, Log, All);
+
+namespace
+{
+	using FIndexSlot = FLeaderboardStore::FIndexSlot;
+
+	// 점수 내림차순. 같은 점수는 먼저 기록된 판이 위 (새 순번은 항상 기존보다 크므로 같은 점수의 뒤에 들어감)
+	void InsertSlot(TArray<FIndexSlot>& List, int32 Capacity, int32 Score, uint32 Ordinal)
+	{
+		const int32 Position = Algo::UpperBoundBy(List, Score, &FIndexSlot::Score, TGreater<>());
+		if (Position >= Capacity)
+		{
+			return;
+		}
+
+		List.Insert(FIndexSlot{ Score, Ordinal }, Position);
+		if (List.Num() > Capacity)
+		{
+			List.Pop(EAllowShrinking::No);
+		}
+	}
+
+	void IndexEntry(TArray<FIndexSlot>* Lists, int32 Capacity, const FLeaderboardEntry& Entry, uint32 Ordinal)
+	{
+		InsertSlot(Lists[0], Capacity, Entry.TotalScore, Ordinal);
+
+		const int32 LevelsPlayed = FMath::Min<int32>(Entry.LevelsPlayed, FLeaderboardEntry::MaxLevels);
+		for (int32 LevelIndex = 0; LevelIndex < LevelsPlayed; LevelIndex++)
+		{
+			InsertSlot(Lists[1 + LevelIndex], Capacity, Entry.LevelScores[LevelIndex], Ordinal);
+		}
+	}
+}
+
+FLeaderboardStore::FLeaderboardStore(const FString& InDirectory, int32 InCapacity)
+	: DataPath(InDirectory / TEXT("Leaderboard.ch8lb"))
+	, IndexPath(InDirectory / TEXT("Leaderboard.ch8lbi"))
+	, Capacity(FMath::Max(InCapacity, 1))
+{
+	for (TArray<FIndexSlot>& List : Lists)
+	{
+		List.Reserve(Capacity + 1);
+	}
+}
+
+FLeaderboardStore::~FLeaderboardStore()
+{
+	Flush();
+
+	WriteHandle.Reset();
+	// 영역을 핸들보다 먼저 해제해야 함
+	MappedRegion.Reset();
+	MappedFile.Reset();
+}
+
+void FLeaderboardStore::Open()
+{
+	IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+	PlatformFile.CreateDirectoryTree(*FPaths::GetPath(DataPath));
+
+	const double StartTime = FPlatformTime::Seconds();
+
+	if (!MapData())
+	{
+		// 형식이 다른 파일은 덮어쓰지 않고 옆으로 치워둠
+		const FString BackupPath = DataPath + TEXT(".bak");
+		UE_LOG(LogLeaderboard, Warning, TEXT("Leaderboard data %s has an unknown format, moved to %s"), *DataPath, *BackupPath);
+		IFileManager::Get().Move(*BackupPath, *DataPath, true);
+		IFileManager::Get().Delete(*IndexPath, false, false, true);
+	}
+
+	if (ReadIndex())
+	{
+		UE_LOG(LogLeaderboard, Log, TEXT("Leaderboard opened: %llu runs, index read in %.2f ms"),
+			NumEntries, (FPlatformTime::Seconds() - StartTime) * 1000.0);
+		return;
+	}
+
+	if (NumMappedEntries > 0)
+	{
+		UE_LOG(LogLeaderboard, Log, TEXT("Leaderboard index missing or stale, rebuilding from %llu runs"), NumMappedEntries);
+		WritePipe.Launch(TEXT("LeaderboardRebuild"), [this]() { RebuildOnPipe(); });
+	}
+}
+
+bool FLeaderboardStore::MapData()
+{
+	IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+	const int64 FileSize = PlatformFile.FileSize(*DataPath);
+	if (FileSize <= 0)
+	{
+		return true;
+	}
+	if (FileSize < static_cast<int64>(sizeof(FDataHeader)))
+	{
+		return false;
+	}
+
+	// 이번 세션에서 덧붙이는 기록이 있으므로 쓰기 공유를 허용
+	FOpenMappedResult MappedResult = PlatformFile.OpenMappedEx(*DataPath, IPlatformFile::EOpenReadFlags::AllowWrite);
+	if (MappedResult.HasError())
+	{
+		UE_LOG(LogLeaderboard, Warning, TEXT("Failed to map leaderboard data %s: %s"), *DataPath, *MappedResult.GetError().GetMessage());
+		return false;
+	}
+	MappedFile = MappedResult.StealValue();
+	MappedRegion.Reset(MappedFile->MapRegion(0, FileSize));
+	if (!MappedRegion)
+	{
+		MappedFile.Reset();
+		return false;
+	}
+
+	const FDataHeader& Header = *reinterpret_cast<const FDataHeader*>(MappedRegion->GetMappedPtr());
+	if (Header.Magic != DataMagic || Header.Version != FileVersion || Header.EntrySize != sizeof(FLeaderboardEntry))
+	{
+		MappedRegion.Reset();
+		MappedFile.Reset();
+		return false;
+	}
+
+	// 마지막 기록이 쓰다 만 상태면 버림 (다음 추가가 그 자리를 덮어씀)
+	NumMappedEntries = (FileSize - sizeof(FDataHeader)) / sizeof(FLeaderboardEntry);
+	NumEntries = NumMappedEntries;
+	return true;
+}
+
+bool FLeaderboardStore::ReadIndex()
+{
+	TArray<uint8> IndexData;
+	if (!FFileHelper::LoadFileToArray(IndexData, *IndexPath, FILEREAD_Silent))
+	{
+		return false;
+	}
+
+	const int64 ListSize = sizeof(uint32) + static_cast<int64>(Capacity) * sizeof(FIndexSlot);
+	if (IndexData.Num() != sizeof(FIndexHeader) + NumLists * ListSize)
+	{
+		return false;
+	}
+
+	const FIndexHeader& Header = *reinterpret_cast<const FIndexHeader*>(IndexData.GetData());
+	if (Header.Magic != IndexMagic || Header.Version != FileVersion || Header.EntrySize != sizeof(FLeaderboardEntry)
+		|| Header.Capacity != static_cast<uint32>(Capacity) || Header.EntryCount > NumMappedEntries)
+	{
+		return false;
+	}
+
+	// 중간에 실패하면 Lists 를 건드리지 않은 채 재구성으로 넘어가도록 다 읽은 뒤에 교체
+	TArray<FIndexSlot> ParsedLists[NumLists];
+	const uint8* Cursor = IndexData.GetData() + sizeof(FIndexHeader);
+	for (TArray<FIndexSlot>& List : ParsedLists)
+	{
+		const uint32 Count = *reinterpret_cast<const uint32*>(Cursor);
+		const FIndexSlot* Slots = reinterpret_cast<const FIndexSlot*>(Cursor + sizeof(uint32));
+		if (Count > static_cast<uint32>(Capacity))
+		{
+			return false;
+		}
+		for (uint32 SlotIndex = 0; SlotIndex < Count; SlotIndex++)
+		{
+			if (Slots[SlotIndex].Ordinal >= Header.EntryCount)
+			{
+				return false;
+			}
+		}
+		List.Reserve(Capacity + 1);
+		List.Append(Slots, Count);
+		Cursor += ListSize;
+	}
+
+	// 색인 저장 전에 종료되어 빠진 뒤쪽 기록만 훑어서 반영
+	FLeaderboardEntry Entry;
+	for (uint64 Ordinal = Header.EntryCount; Ordinal < NumMappedEntries; Ordinal++)
+	{
+		ReadEntry(static_cast<uint32>(Ordinal), Entry);
+		IndexEntry(ParsedLists, Capacity, Entry, static_cast<uint32>(Ordinal));
+	}
+
+	for (int32 ListIndex = 0; ListIndex < NumLists; ListIndex++)
+	{
+		Lists[ListIndex] = MoveTemp(ParsedLists[ListIndex]);
+	}
+	return true;
+}
+
+bool FLeaderboardStore::ReadEntry(uint32 Ordinal, FLeaderboardEntry& OutEntry) const
+{
+	if (Ordinal < NumMappedEntries)
+	{
+		const uint8* EntryPtr = MappedRegion->GetMappedPtr() + sizeof(FDataHeader) + static_cast<uint64>(Ordinal) * sizeof(FLeaderboardEntry);
+		FMemory::Memcpy(&OutEntry, EntryPtr, sizeof(FLeaderboardEntry));
+		return true;
+	}
+
+	const uint64 TailIndex = Ordinal - NumMappedEntries;
+	if (TailIndex < static_cast<uint64>(TailEntries.Num()))
+	{
+		OutEntry = TailEntries[TailIndex];
+		return true;
+	}
+	return false;
+}
+
+void FLeaderboardStore::Append(const FLeaderboardEntry& Entry)
+{
+	uint64 Ordinal = 0;
+	{
+		// 목록은 바로 갱신해서 메인 메뉴가 방금 끝난 판을 보여줄 수 있게 함
+		FScopeLock ScopeLock(&Lock);
+		Ordinal = NumEntries++;
+		TailEntries.Add(Entry);
+		IndexEntry(Lists, Capacity, Entry, static_cast<uint32>(Ordinal));
+	}
+
+	WritePipe.Launch(TEXT("LeaderboardAppend"), [this, Entry, Ordinal]() { AppendOnPipe(Entry, Ordinal); });
+}
+
+void FLeaderboardStore::Flush()
+{
+	WritePipe.WaitUntilEmpty();
+}
+
+void FLeaderboardStore::AppendOnPipe(const FLeaderboardEntry& Entry, uint64 Ordinal)
+{
+	if (!WriteHandle)
+	{
+		WriteHandle.Reset(FPlatformFileManager::Get().GetPlatformFile().OpenWrite(*DataPath, true, true));
+		if (!WriteHandle)
+		{
+			UE_LOG(LogLeaderboard, Warning, TEXT("Failed to open leaderboard data %s for writing"), *DataPath);
+			return;
+		}
+		if (WriteHandle->Size() < static_cast<int64>(sizeof(FDataHeader)))
+		{
+			const FDataHeader Header;
+			WriteHandle->Seek(0);
+			WriteHandle->Write(reinterpret_cast<const uint8*>(&Header), sizeof(Header));
+		}
+	}
+
+	// 파일 끝이 아니라 순번 위치에 씀 (쓰다 만 기록이 있으면 덮어씀)
+	WriteHandle->Seek(sizeof(FDataHeader) + Ordinal * sizeof(FLeaderboardEntry));
+	WriteHandle->Write(reinterpret_cast<const uint8*>(&Entry), sizeof(Entry));
+	WriteHandle->Flush();
+
+	WriteIndex();
+}
+
+void FLeaderboardStore::RebuildOnPipe()
+{
+	const double StartTime = FPlatformTime::Seconds();
+
+	// 매핑된 영역은 열린 뒤 바뀌지 않으므로 잠금 없이 훑음
+	TArray<FIndexSlot> RebuiltLists[NumLists];
+	FLeaderboardEntry Entry;
+	for (uint64 Ordinal = 0; Ordinal < NumMappedEntries; Ordinal++)
+	{
+		ReadEntry(static_cast<uint32>(Ordinal), Entry);
+		IndexEntry(RebuiltLists, Capacity, Entry, static_cast<uint32>(Ordinal));
+	}
+
+	{
+		// 재구성 중에 추가된 판(모두 매핑 이후 순번)을 합친 뒤 교체
+		FScopeLock ScopeLock(&Lock);
+		for (int32 ListIndex = 0; ListIndex < NumLists; ListIndex++)
+		{
+			for (const FIndexSlot& Slot : Lists[ListIndex])
+			{
+				InsertSlot(RebuiltLists[ListIndex], Capacity, Slot.Score, Slot.Ordinal);
+			}
+			Lists[ListIndex] = MoveTemp(RebuiltLists[ListIndex]);
+		}
+	}
+
+	WriteIndex();
+
+	UE_LOG(LogLeaderboard, Log, TEXT("Leaderboard index rebuilt from %llu runs in %.2f ms"),
+		NumMappedEntries, (FPlatformTime::Seconds() - StartTime) * 1000.0);
+}
+
+void FLeaderboardStore::WriteIndex() const
+{
+	TArray<uint8> IndexData;
+	{
+		FScopeLock ScopeLock(&Lock);
+
+		// 목록이 반영한 기록 수. 아직 파일에 없는 판이 포함될 수 있으나 그 경우 다음 실행에서 색인이 거부되어 재구성됨
+		FIndexHeader Header;
+		Header.Capacity = Capacity;
+		Header.EntryCount = NumEntries;
+		IndexData.Append(reinterpret_cast<const uint8*>(&Header), sizeof(Header));
+
+		for (const TArray<FIndexSlot>& List : Lists)
+		{
+			const uint32 Count = List.Num();
+			IndexData.Append(reinterpret_cast<const uint8*>(&Count), sizeof(Count));
+			IndexData.Append(reinterpret_cast<const uint8*>(List.GetData()), List.Num() * sizeof(FIndexSlot));
+			IndexData.AddZeroed((Capacity - List.Num()) * sizeof(FIndexSlot));
+		}
+	}
+
+	// 임시 파일에 쓴 뒤 교체해서 쓰는 도중 종료되어도 이전 색인이 남도록
+	const FString TempPath = IndexPath + TEXT(".tmp");
+	if (!FFileHelper::SaveArrayToFile(IndexData, *TempPath) || !IFileManager::Get().Move(*IndexPath, *TempPath, true))
+	{
+		UE_LOG(LogLeaderboard, Warning, TEXT("Failed to write leaderboard index %s"), *IndexPath);
+	}
+}
+
+void FLeaderboardStore::GetTop(int32 Count, TArray<FLeaderboardEntry>& OutEntries, int32 LevelIndex) const
+{
+	OutEntries.Reset();
+
+	const int32 ListIndex = LevelIndex == INDEX_NONE ? 0 : 1 + LevelIndex;
+	if (ListIndex < 0 || ListIndex >= NumLists)
+	{
+		return;
+	}
+
+	FScopeLock ScopeLock(&Lock);
+	const TArray<FIndexSlot>& List = Lists[ListIndex];
+	const int32 NumToRead = FMath::Min(Count, List.Num());
+	OutEntries.Reserve(NumToRead);
+	for (int32 SlotIndex = 0; SlotIndex < NumToRead; SlotIndex++)
+	{
+		if (!ReadEntry(List[SlotIndex].Ordinal, OutEntries.AddDefaulted_GetRef()))
+		{
+			OutEntries.Pop(EAllowShrinking::No);
+		}
+	}
+}
+
+uint64 FLeaderboardStore::GetNumEntries() const
+{
+	FScopeLock ScopeLock(&Lock);
+	return NumEntries;
+}
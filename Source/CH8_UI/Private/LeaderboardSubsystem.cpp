@@ -0,0 +1,78 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "LeaderboardSubsystem.h"
+#include "BaseGameInstance.h"
+#include "SoakRunSubsystem.h"
+#include "Misc/Paths.h"
+
+bool ULeaderboardSubsystem::ShouldCreateSubsystem(UObject* Outer) const
+{
+	return !USoakRunSubsystem::IsSoakRequested();
+}
+
+void ULeaderboardSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	Store = MakeUnique<FLeaderboardStore>(FPaths::ProjectSavedDir() / TEXT("Leaderboard"), IndexCapacity);
+	Store->Open();
+}
+
+void ULeaderboardSubsystem::Deinitialize()
+{
+	// 소멸자에서 남은 쓰기를 마저 끝냄
+	Store.Reset();
+
+	Super::Deinitialize();
+}
+
+void ULeaderboardSubsystem::RecordRun(const UBaseGameInstance& GameInstance, bool bGameCleared)
+{
+	if (!Store)
+	{
+		return;
+	}
+
+	FLeaderboardEntry Entry;
+	Entry.UtcTicks = FDateTime::UtcNow().GetTicks();
+	Entry.TotalScore = GameInstance.TotalScore;
+	Entry.Seed = GameInstance.RunSeed;
+	// 메뉴를 거치지 않고 레벨에서 바로 시작한 경우(PIE 등)에는 시작 시각이 없음
+	Entry.DurationSec = GameInstance.RunStartTime > 0.0 ? static_cast<float>(FPlatformTime::Seconds() - GameInstance.RunStartTime) : 0.0f;
+	Entry.LevelsPlayed = static_cast<uint8>(FMath::Clamp(GameInstance.LevelScores.Num(), 0, FLeaderboardEntry::MaxLevels));
+	Entry.Flags = bGameCleared ? FLeaderboardEntry::GameCleared : 0;
+	for (int32 LevelIndex = 0; LevelIndex < Entry.LevelsPlayed; LevelIndex++)
+	{
+		Entry.LevelScores[LevelIndex] = GameInstance.LevelScores[LevelIndex];
+	}
+
+	Store->Append(Entry);
+}
+
+void ULeaderboardSubsystem::GetTopEntries(int32 Count, TArray<FLeaderboardEntry>& OutEntries, int32 LevelIndex) const
+{
+	OutEntries.Reset();
+	if (Store)
+	{
+		Store->GetTop(Count, OutEntries, LevelIndex);
+	}
+}
+
+FString ULeaderboardSubsystem::FormatTopEntries(int32 Count) const
+{
+	TArray<FLeaderboardEntry> Entries;
+	GetTopEntries(Count, Entries);
+
+	FString Result;
+	for (int32 Rank = 0; Rank < Entries.Num(); Rank++)
+	{
+		const FLeaderboardEntry& Entry = Entries[Rank];
+		const FDateTime Date = FDateTime(Entry.UtcTicks);
+		Result += FString::Printf(TEXT("%2d. %6d  L%d%s  %d:%02d  %s\n"),
+			Rank + 1, Entry.TotalScore, Entry.LevelsPlayed, (Entry.Flags & FLeaderboardEntry::GameCleared) ? TEXT("*") : TEXT(""),
+			FMath::FloorToInt(Entry.DurationSec / 60.0f), FMath::FloorToInt(Entry.DurationSec) % 60,
+			*Date.ToString(TEXT("%Y-%m-%d")));
+	}
+	return Result;
+}
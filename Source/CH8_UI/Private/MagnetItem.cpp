@@ -0,0 +1,20 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "MagnetItem.h"
+
+AMagnetItem::AMagnetItem()
+{
+	MagnetRadius = 1500.0f;
+	MagnetDuration = 5.0f;
+	PullSpeed = 1500.0f;
+	ItemType = "Magnet";
+}
+
+void AMagnetItem::DescribeEffect(FItemEffectRow& OutEffect) const
+{
+	OutEffect.EffectType = EItemEffectType::Magnet;
+	OutEffect.Magnitude = PullSpeed;
+	OutEffect.Radius = MagnetRadius;
+	OutEffect.Duration = MagnetDuration;
+}
\ No newline at end of file
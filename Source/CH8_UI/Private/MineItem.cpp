@@ -1,6 +1,5 @@
 #include "MineItem.h"
 #include "Components/SphereComponent.h"
-#include "Kismet/GameplayStatics.h"
 
 AMineItem::AMineItem()
 {
@@ -15,37 +14,12 @@ AMineItem::AMineItem()
 	ExplosionCollision->SetupAttachment(Scene);
 }
 
-void AMineItem::ActivateItem(AActor* Activator)
+void AMineItem::DescribeEffect(FItemEffectRow& OutEffect) const
 {
-	GetWorld()->GetTimerManager().SetTimer(
-		ExplosionTimerHandle,
-		this,
-		&AMineItem::Explode,
-		ExplosionDelay,
-		false
-	);
-}
-
-void AMineItem::Explode()
-{
-	TArray<AActor*> OverlappingActors;
-	ExplosionCollision->GetOverlappingActors(OverlappingActors);
-	
-	for (AActor* Actor : OverlappingActors)
-	{
-		if (Actor && Actor->ActorHasTag("Player"))
-		{
-			// 데미지를 발생시켜 Actor->TakeDamage()가 실행되도록 함
-			UGameplayStatics::ApplyDamage(
-				Actor,                      // 데미지를 받을 액터
-				ExplosionDamage,            // 데미지 양
-				nullptr,                    // 데미지를 유발한 주체 (지뢰를 설치한 캐릭터가 없으므로 nullptr)
-				this,                       // 데미지를 유발한 오브젝트(지뢰)
-				UDamageType::StaticClass()  // 기본 데미지 유형
-			);
-		}
-	}
-	
-	// 폭발 이후 지뢰 아이템 파괴
-	DestroyItem();
+	// 밟으면 ExplosionDelay 후 폭발하고, 폭발 이후 지뢰 아이템 파괴
+	OutEffect.EffectType = EItemEffectType::RadialDamage;
+	OutEffect.Magnitude = ExplosionDamage;
+	OutEffect.Delay = ExplosionDelay;
+	OutEffect.Radius = ExplosionRadius;
+	OutEffect.bDestroyOnActivate = false;
 }
\ No newline at end of file
@@ -0,0 +1,376 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "RivalCollectorSubsystem.h"
+#include "BaseGameState.h"
+#include "CoinItem.h"
+#include "CoinSpatialIndexSubsystem.h"
+#include "ItemEffectSubsystem.h"
+#include "RivalCollectorsActor.h"
+#include "SpawnVolume.h"
+#include "Components/InstancedStaticMeshComponent.h"
+#include "Engine/StaticMesh.h"
+#include "Engine/World.h"
+#include "EngineUtils.h"
+#include "Misc/CommandLine.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+
+DEFINE_LOG_CATEGORY(LogRivals);
+
+bool URivalCollectorSubsystem::ShouldCreateSubsystem(UObject* Outer) const
+{
+	const UWorld* World = Cast<UWorld>(Outer);
+	return World && World->IsGameWorld();
+}
+
+TStatId URivalCollectorSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(URivalCollectorSubsystem, STATGROUP_Tickables);
+}
+
+int32 URivalCollectorSubsystem::GetBestRivalScore() const
+{
+	int32 BestScore = 0;
+	for (const int32 Score : Scores)
+	{
+		BestScore = FMath::Max(BestScore, Score);
+	}
+	return BestScore;
+}
+
+void URivalCollectorSubsystem::OnLevelStarted()
+{
+	int32 Count = NumRivals;
+	FParse::Value(FCommandLine::Get(), TEXT("CH8Rivals="), Count);
+	if (Count > 0)
+	{
+		SpawnRivals(Count);
+	}
+}
+
+ARivalCollectorsActor* URivalCollectorSubsystem::GetOrCreateRenderActor()
+{
+	if (RenderActor)
+	{
+		return RenderActor;
+	}
+
+	FActorSpawnParameters SpawnParams;
+	SpawnParams.ObjectFlags |= RF_Transient;
+	SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+	RenderActor = GetWorld()->SpawnActor<ARivalCollectorsActor>(FVector::ZeroVector, FRotator::ZeroRotator, SpawnParams);
+	if (RenderActor)
+	{
+		if (UStaticMesh* Mesh = RivalMesh.LoadSynchronous())
+		{
+			RenderActor->GetInstances()->SetStaticMesh(Mesh);
+		}
+		else
+		{
+			UE_LOG(LogRivals, Warning, TEXT("Rival mesh %s could not be loaded, rivals are invisible"), *RivalMesh.ToString());
+		}
+	}
+	return RenderActor;
+}
+
+void URivalCollectorSubsystem::SpawnRivals(int32 Count)
+{
+	Count = FMath::Max(Count, 0);
+
+	PosX.Reset();
+	PosY.Reset();
+	PosZ.Reset();
+	Targets.Reset();
+	RetargetTimers.Reset();
+	Scores.Reset();
+	TotalRivalScore = 0;
+	NextRetarget = 0;
+	bFrozen = false;
+
+	// 플레이어와 같은 분포로 시작하도록 스폰 볼륨의 검증된 지점에서
+	TActorIterator<ASpawnVolume> VolumeIt(GetWorld());
+	const ASpawnVolume* SpawnVolume = VolumeIt ? *VolumeIt : nullptr;
+
+	PosX.Reserve(Count);
+	PosY.Reserve(Count);
+	PosZ.Reserve(Count);
+	Targets.Reserve(Count);
+	RetargetTimers.Reserve(Count);
+	Scores.Reserve(Count);
+	for (int32 Index = 0; Index < Count; Index++)
+	{
+		const FVector Location = SpawnVolume ? SpawnVolume->GetRandomPointInVolume() : FVector::ZeroVector;
+		PosX.Add(Location.X);
+		PosY.Add(Location.Y);
+		PosZ.Add(Location.Z);
+		Targets.AddDefaulted();
+		// 첫 목표 탐색이 한 프레임에 몰리지 않도록 흩어둠
+		RetargetTimers.Add(FMath::FRandRange(0.0f, RetargetInterval));
+		Scores.Add(0);
+	}
+
+	ClaimedCoins.Reserve(Count);
+	QueryResult.Reserve(64);
+
+	if (ARivalCollectorsActor* Actor = GetOrCreateRenderActor())
+	{
+		UInstancedStaticMeshComponent* Instances = Actor->GetInstances();
+		Instances->ClearInstances();
+
+		InstanceTransforms.SetNum(Count, EAllowShrinking::No);
+		for (int32 Index = 0; Index < Count; Index++)
+		{
+			InstanceTransforms[Index] = FTransform(FQuat::Identity, FVector(PosX[Index], PosY[Index], PosZ[Index]), RivalScale);
+		}
+		Instances->AddInstances(InstanceTransforms, false, true);
+	}
+
+	UE_LOG(LogRivals, Log, TEXT("Spawned %d rival collectors"), Count);
+}
+
+void URivalCollectorSubsystem::OnGameOver()
+{
+	bFrozen = true;
+	for (TWeakObjectPtr<ACoinItem>& Target : Targets)
+	{
+		Target.Reset();
+	}
+
+#if !UE_BUILD_SHIPPING
+	if (Benchmark.bRunning)
+	{
+		UE_LOG(LogRivals, Display, TEXT("Rival benchmark aborted by game over"));
+		Benchmark.bRunning = false;
+	}
+#endif
+}
+
+void URivalCollectorSubsystem::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	if (PosX.IsEmpty() || bFrozen)
+	{
+		return;
+	}
+
+	const double StartTime = FPlatformTime::Seconds();
+	UpdateRivals(DeltaTime);
+	const double TickMs = (FPlatformTime::Seconds() - StartTime) * 1000.0;
+	AverageTickMs = AverageTickMs > 0.0 ? FMath::Lerp(AverageTickMs, TickMs, 0.05) : TickMs;
+
+#if !UE_BUILD_SHIPPING
+	if (Benchmark.bRunning)
+	{
+		AdvanceBenchmark(TickMs);
+	}
+#endif
+}
+
+void URivalCollectorSubsystem::UpdateRivals(float DeltaTime)
+{
+	AssignTargets();
+
+	// 모든 라이벌을 목표 코인 쪽으로 한 번에 이동
+	const int32 NumRivalsNow = PosX.Num();
+	const float MaxStep = MoveSpeed * DeltaTime;
+	const float CollectDistanceSquared = FMath::Square(CollectDistance);
+	for (int32 Index = 0; Index < NumRivalsNow; Index++)
+	{
+		RetargetTimers[Index] -= DeltaTime;
+
+		ACoinItem* Coin = Targets[Index].Get();
+		if (!Coin)
+		{
+			continue;
+		}
+
+		const FVector Goal = Coin->GetActorLocation();
+		const float DeltaX = Goal.X - PosX[Index];
+		const float DeltaY = Goal.Y - PosY[Index];
+		const float DeltaZ = Goal.Z - PosZ[Index];
+		const float DistanceSquared = DeltaX * DeltaX + DeltaY * DeltaY + DeltaZ * DeltaZ;
+		const float Alpha = FMath::Min(MaxStep * FMath::InvSqrt(FMath::Max(DistanceSquared, UE_KINDA_SMALL_NUMBER)), 1.0f);
+		PosX[Index] += DeltaX * Alpha;
+		PosY[Index] += DeltaY * Alpha;
+		PosZ[Index] += DeltaZ * Alpha;
+
+		if (DistanceSquared * FMath::Square(1.0f - Alpha) <= CollectDistanceSquared)
+		{
+#if !UE_BUILD_SHIPPING
+			// 벤치마크 중에는 웨이브가 끝나지 않도록 획득하지 않고 코인 위에 머무름
+			if (Benchmark.bRunning)
+			{
+				continue;
+			}
+#endif
+			CollectCoin(Index, Coin);
+		}
+	}
+
+	UpdateInstances();
+}
+
+void URivalCollectorSubsystem::AssignTargets()
+{
+	UCoinSpatialIndexSubsystem* SpatialIndex = GetWorld()->GetSubsystem<UCoinSpatialIndexSubsystem>();
+	if (!SpatialIndex)
+	{
+		return;
+	}
+
+	// 다른 라이벌이 노리는 코인 (사라진 코인은 약한 포인터가 끊어져 자연히 빠짐)
+	ClaimedCoins.Reset();
+	for (const TWeakObjectPtr<ACoinItem>& Target : Targets)
+	{
+		if (const ACoinItem* Coin = Target.Get())
+		{
+			ClaimedCoins.Add(Coin);
+		}
+	}
+
+	const int32 NumRivalsNow = PosX.Num();
+	int32 NumSearched = 0;
+	for (int32 Checked = 0; Checked < NumRivalsNow && NumSearched < RetargetsPerFrame; Checked++)
+	{
+		const int32 Index = NextRetarget;
+		NextRetarget = (NextRetarget + 1) % NumRivalsNow;
+
+		ACoinItem* CurrentCoin = Targets[Index].Get();
+		if (CurrentCoin && RetargetTimers[Index] > 0.0f)
+		{
+			continue;
+		}
+		NumSearched++;
+		RetargetTimers[Index] = RetargetInterval;
+
+		const FVector Position(PosX[Index], PosY[Index], PosZ[Index]);
+		QueryResult.Reset();
+		SpatialIndex->QueryCoinsInRadius(Position, SearchRadius, QueryResult);
+
+		ACoinItem* BestCoin = CurrentCoin;
+		float BestDistanceSquared = CurrentCoin ? FVector::DistSquared(Position, CurrentCoin->GetActorLocation()) : MAX_flt;
+		for (ACoinItem* Coin : QueryResult)
+		{
+			if (Coin == CurrentCoin || Coin->IsEffectPending() || ClaimedCoins.Contains(Coin))
+			{
+				continue;
+			}
+
+			const float DistanceSquared = FVector::DistSquared(Position, Coin->GetActorLocation());
+			if (DistanceSquared < BestDistanceSquared)
+			{
+				BestCoin = Coin;
+				BestDistanceSquared = DistanceSquared;
+			}
+		}
+
+		if (BestCoin != CurrentCoin)
+		{
+			ClaimedCoins.Remove(CurrentCoin);
+			ClaimedCoins.Add(BestCoin);
+			Targets[Index] = BestCoin;
+		}
+	}
+}
+
+void URivalCollectorSubsystem::CollectCoin(int32 RivalIndex, ACoinItem* Coin)
+{
+	Targets[RivalIndex].Reset();
+	RetargetTimers[RivalIndex] = 0.0f;
+
+	// 웨이브 사이나 게임 오버 뒤에는 웨이브 완료를 일으키지 않도록 줍지 않음
+	const ABaseGameState* GameState = GetWorld()->GetGameState<ABaseGameState>();
+	if (!GameState || !GameState->IsWaveActive())
+	{
+		return;
+	}
+
+	const UItemEffectSubsystem* EffectSubsystem = GetWorld()->GetSubsystem<UItemEffectSubsystem>();
+	FItemEffectRow Effect;
+	if (!EffectSubsystem || !EffectSubsystem->ResolveEffect(*Coin, Effect) || !RenderActor)
+	{
+		return;
+	}
+
+	// 플레이어와 같은 획득 경로. 코인 완료는 효과 처리에서, 점수는 라이벌 쪽에만 쌓음
+	static_cast<IItemInterface*>(Coin)->ActivateItem(RenderActor);
+	if (Coin->IsEffectPending() || Coin->IsActorBeingDestroyed())
+	{
+		const int32 Points = FMath::RoundToInt(Effect.Magnitude);
+		Scores[RivalIndex] += Points;
+		TotalRivalScore += Points;
+	}
+}
+
+void URivalCollectorSubsystem::UpdateInstances()
+{
+	if (!RenderActor)
+	{
+		return;
+	}
+
+	const int32 NumRivalsNow = PosX.Num();
+	InstanceTransforms.SetNum(NumRivalsNow, EAllowShrinking::No);
+	for (int32 Index = 0; Index < NumRivalsNow; Index++)
+	{
+		InstanceTransforms[Index].SetLocation(FVector(PosX[Index], PosY[Index], PosZ[Index]));
+	}
+	RenderActor->GetInstances()->BatchUpdateInstancesTransforms(0, InstanceTransforms, true, true, true);
+}
+
+#if !UE_BUILD_SHIPPING
+void URivalCollectorSubsystem::DebugStartBenchmark(int32 MaxRivals, int32 Step, int32 FramesPerStep)
+{
+	Benchmark = FBenchmarkState();
+	Benchmark.bRunning = true;
+	Benchmark.Step = FMath::Max(Step, 1);
+	Benchmark.MaxRivals = FMath::Max(MaxRivals, Benchmark.Step);
+	Benchmark.FramesPerStep = FMath::Max(FramesPerStep, 1);
+	Benchmark.RestoreCount = GetNumRivals();
+
+	UE_LOG(LogRivals, Display, TEXT("Rival benchmark: up to %d rivals in steps of %d, %d frames per step"),
+		Benchmark.MaxRivals, Benchmark.Step, Benchmark.FramesPerStep);
+	SpawnRivals(Benchmark.Step);
+}
+
+void URivalCollectorSubsystem::AdvanceBenchmark(double TickMs)
+{
+	Benchmark.StepTotalMs += TickMs;
+	if (++Benchmark.FrameInStep < Benchmark.FramesPerStep)
+	{
+		return;
+	}
+
+	Benchmark.Results.Emplace(GetNumRivals(), Benchmark.StepTotalMs / Benchmark.FramesPerStep);
+	Benchmark.FrameInStep = 0;
+	Benchmark.StepTotalMs = 0.0;
+
+	const int32 NextCount = GetNumRivals() + Benchmark.Step;
+	if (NextCount <= Benchmark.MaxRivals)
+	{
+		SpawnRivals(NextCount);
+		return;
+	}
+
+	Benchmark.bRunning = false;
+
+	TArray<FString> Lines;
+	Lines.Add(TEXT("Rivals,AverageTickMs,MsPer100Rivals"));
+	for (const TPair<int32, double>& Result : Benchmark.Results)
+	{
+		const double MsPer100 = Result.Value * 100.0 / Result.Key;
+		UE_LOG(LogRivals, Display, TEXT("Rival benchmark: %4d rivals  %.3f ms/frame  %.3f ms per 100 rivals"), Result.Key, Result.Value, MsPer100);
+		Lines.Add(FString::Printf(TEXT("%d,%.4f,%.4f"), Result.Key, Result.Value, MsPer100));
+	}
+
+	const FString OutPath = FPaths::ProjectSavedDir() / TEXT("Benchmarks") / FString::Printf(TEXT("RivalBenchmark-%s.csv"), *FDateTime::Now().ToString());
+	if (FFileHelper::SaveStringArrayToFile(Lines, *OutPath))
+	{
+		UE_LOG(LogRivals, Display, TEXT("Rival benchmark written to %s"), *OutPath);
+	}
+
+	SpawnRivals(Benchmark.RestoreCount);
+}
+#endif
@@ -0,0 +1,21 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "RivalCollectorsActor.h"
+#include "Components/InstancedStaticMeshComponent.h"
+
+const FName ARivalCollectorsActor::RivalTag(TEXT("Rival"));
+
+ARivalCollectorsActor::ARivalCollectorsActor()
+{
+	PrimaryActorTick.bCanEverTick = false;
+	Tags.Add(RivalTag);
+
+	// 인스턴스 변환은 월드 원점 기준으로 넣으므로 액터는 원점에 둠
+	Instances = CreateDefaultSubobject<UInstancedStaticMeshComponent>(TEXT("Instances"));
+	SetRootComponent(Instances);
+	Instances->SetMobility(EComponentMobility::Movable);
+	Instances->SetCollisionEnabled(ECollisionEnabled::NoCollision);
+	Instances->SetGenerateOverlapEvents(false);
+	Instances->SetCastShadow(false);
+}
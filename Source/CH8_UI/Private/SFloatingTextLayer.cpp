@@ -0,0 +1,46 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "SFloatingTextLayer.h"
+#include "FloatingTextSubsystem.h"
+#include "Rendering/DrawElements.h"
+
+void SFloatingTextLayer::Construct(const FArguments& InArgs)
+{
+	Subsystem = InArgs._Subsystem;
+	SetVisibility(EVisibility::HitTestInvisible);
+}
+
+int32 SFloatingTextLayer::OnPaint(const FPaintArgs& Args, const FGeometry& AllottedGeometry, const FSlateRect& MyCullingRect,
+	FSlateWindowElementList& OutDrawElements, int32 LayerId, const FWidgetStyle& InWidgetStyle, bool bParentEnabled) const
+{
+	const UFloatingTextSubsystem* FloatingText = Subsystem.Get();
+	if (!FloatingText)
+	{
+		return LayerId;
+	}
+
+	// 투영 결과는 뷰포트 픽셀이고, 이 레이어의 로컬 좌표는 DPI 스케일이 적용된 슬레이트 단위
+	const float InvScale = 1.0f / FMath::Max(AllottedGeometry.Scale, UE_SMALL_NUMBER);
+	const FSlateFontInfo& Font = FloatingText->GetFont();
+
+	for (const FFloatingTextDrawItem& Item : FloatingText->GetDrawItems())
+	{
+		const FVector2f LocalPosition = Item.ScreenPosition * InvScale - Item.HalfSize;
+		FSlateDrawElement::MakeText(
+			OutDrawElements,
+			LayerId,
+			AllottedGeometry.ToPaintGeometry(Item.HalfSize * 2.0f, FSlateLayoutTransform(LocalPosition)),
+			*Item.Text,
+			Font,
+			ESlateDrawEffect::None,
+			Item.Color);
+	}
+
+	return LayerId;
+}
+
+FVector2D SFloatingTextLayer::ComputeDesiredSize(float LayoutScaleMultiplier) const
+{
+	return FVector2D::ZeroVector;
+}
@@ -0,0 +1,26 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Widgets/SLeafWidget.h"
+
+class UFloatingTextSubsystem;
+
+// UFloatingTextSubsystem 이 계산해둔 팝업 목록을 한 번의 OnPaint 로 그리는 전체 화면 레이어
+class SFloatingTextLayer : public SLeafWidget
+{
+public:
+	SLATE_BEGIN_ARGS(SFloatingTextLayer) {}
+		SLATE_ARGUMENT(TWeakObjectPtr<const UFloatingTextSubsystem>, Subsystem)
+	SLATE_END_ARGS()
+
+	void Construct(const FArguments& InArgs);
+
+	virtual int32 OnPaint(const FPaintArgs& Args, const FGeometry& AllottedGeometry, const FSlateRect& MyCullingRect,
+		FSlateWindowElementList& OutDrawElements, int32 LayerId, const FWidgetStyle& InWidgetStyle, bool bParentEnabled) const override;
+	virtual FVector2D ComputeDesiredSize(float LayoutScaleMultiplier) const override;
+
+private:
+	TWeakObjectPtr<const UFloatingTextSubsystem> Subsystem;
+};
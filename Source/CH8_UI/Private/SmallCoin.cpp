@@ -8,8 +8,3 @@ ASmallCoin::ASmallCoin()
 	PointValue = 10;
 	ItemType = "SmallCoin";
 }
-
-void ASmallCoin::ActivateItem(AActor* Activator)
-{
-	Super::ActivateItem(Activator);
-}
@@ -0,0 +1,265 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "SoakRunSubsystem.h"
+#include "BaseGameInstance.h"
+#include "CH8_UI/CH8_UICharacter.h"
+#include "GameplayStatistics.h"
+#include "Engine/World.h"
+#include "HAL/FileManager.h"
+#include "HAL/PlatformMemory.h"
+#include "Kismet/GameplayStatics.h"
+#include "Misc/CommandLine.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "RenderCore.h"
+#include "TimerManager.h"
+#include "UObject/UObjectGlobals.h"
+
+DEFINE_LOG_CATEGORY(LogSoakRun);
+
+namespace
+{
+	FString GetResultFilePath()
+	{
+		return FPaths::ProjectSavedDir() / TEXT("Soak") / TEXT("SoakResults.csv");
+	}
+}
+
+bool USoakRunSubsystem::IsSoakRequested()
+{
+	int32 Runs = 0;
+	return FParse::Value(FCommandLine::Get(), TEXT("SoakRuns="), Runs) && Runs > 0;
+}
+
+bool USoakRunSubsystem::ShouldCreateSubsystem(UObject* Outer) const
+{
+	return IsSoakRequested();
+}
+
+void USoakRunSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	FParse::Value(FCommandLine::Get(), TEXT("SoakRuns="), RunsRequested);
+	RunsRequested = FMath::Max(RunsRequested, 1);
+	FrameTimesMs.Reserve(60 * 60);
+
+	PreLoadMapHandle = FCoreUObjectDelegates::PreLoadMap.AddUObject(this, &USoakRunSubsystem::OnPreLoadMap);
+	PostLoadMapHandle = FCoreUObjectDelegates::PostLoadMapWithWorld.AddUObject(this, &USoakRunSubsystem::OnPostLoadMap);
+
+	IFileManager::Get().Delete(*GetResultFilePath(), false, false, true);
+	AppendResultRow(TEXT("Run,Kind,Level,Wave,Outcome,Frames,P50Ms,P95Ms,P99Ms,Hitches,PeakMemoryMB,TransitionSec,Result"));
+
+	UE_LOG(LogSoakRun, Display, TEXT("Soak run started: %d runs"), RunsRequested);
+}
+
+void USoakRunSubsystem::Deinitialize()
+{
+	FCoreUObjectDelegates::PreLoadMap.Remove(PreLoadMapHandle);
+	FCoreUObjectDelegates::PostLoadMapWithWorld.Remove(PostLoadMapHandle);
+
+	Super::Deinitialize();
+}
+
+void USoakRunSubsystem::Tick(float DeltaTime)
+{
+	if (!bInWave)
+	{
+		return;
+	}
+
+	// 직전 프레임의 게임 스레드 작업 시간 (대기 시간 제외)
+	const float FrameMs = FPlatformTime::ToMilliseconds(GGameThreadTime);
+	FrameTimesMs.Add(FrameMs);
+	if (FrameMs > HitchThresholdMs)
+	{
+		HitchCount++;
+	}
+
+	// 메모리 통계는 플랫폼에 따라 비싸므로 주기적으로만 샘플링
+	const double Now = FPlatformTime::Seconds();
+	if (Now >= NextMemorySampleTime)
+	{
+		NextMemorySampleTime = Now + 0.5;
+		PeakUsedPhysical = FMath::Max<uint64>(PeakUsedPhysical, FPlatformMemory::GetStats().UsedPhysical);
+	}
+}
+
+ETickableTickType USoakRunSubsystem::GetTickableTickType() const
+{
+	return HasAnyFlags(RF_ClassDefaultObject) ? ETickableTickType::Never : ETickableTickType::Always;
+}
+
+TStatId USoakRunSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(USoakRunSubsystem, STATGROUP_Tickables);
+}
+
+void USoakRunSubsystem::OnWaveStarted(int32 LevelIndex, int32 InWaveIndex)
+{
+	// 메뉴를 거치지 않고 게임 레벨로 바로 실행한 경우
+	RunsStarted = FMath::Max(RunsStarted, 1);
+
+	bInWave = true;
+	WaveLevelIndex = LevelIndex;
+	WaveIndex = InWaveIndex;
+	FrameTimesMs.Reset();
+	HitchCount = 0;
+	PeakUsedPhysical = FPlatformMemory::GetStats().UsedPhysical;
+	NextMemorySampleTime = 0.0;
+}
+
+void USoakRunSubsystem::OnWaveEnded(const TCHAR* Outcome)
+{
+	if (!bInWave)
+	{
+		return;
+	}
+	bInWave = false;
+
+	FrameTimesMs.Sort();
+	const float P50 = CH8Stats::SortedPercentile(FrameTimesMs, 0.50f);
+	const float P95 = CH8Stats::SortedPercentile(FrameTimesMs, 0.95f);
+	const float P99 = CH8Stats::SortedPercentile(FrameTimesMs, 0.99f);
+	const float PeakMemoryMB = static_cast<float>(PeakUsedPhysical / (1024.0 * 1024.0));
+
+	const FSoakWaveBudget& Budget = FindBudget(WaveLevelIndex, WaveIndex);
+	TArray<FString, TInlineAllocator<4>> Violations;
+	if (P95 > Budget.MaxP95FrameMs)
+	{
+		Violations.Add(FString::Printf(TEXT("P95 %.1fms > %.1fms"), P95, Budget.MaxP95FrameMs));
+	}
+	if (P99 > Budget.MaxP99FrameMs)
+	{
+		Violations.Add(FString::Printf(TEXT("P99 %.1fms > %.1fms"), P99, Budget.MaxP99FrameMs));
+	}
+	if (HitchCount > Budget.MaxHitches)
+	{
+		Violations.Add(FString::Printf(TEXT("hitches %d > %d"), HitchCount, Budget.MaxHitches));
+	}
+	if (PeakMemoryMB > Budget.MaxMemoryMB)
+	{
+		Violations.Add(FString::Printf(TEXT("memory %.0fMB > %.0fMB"), PeakMemoryMB, Budget.MaxMemoryMB));
+	}
+
+	if (Violations.Num() > 0)
+	{
+		BudgetFailures++;
+		UE_LOG(LogSoakRun, Error, TEXT("Run %d Level %d Wave %d over budget: %s"),
+			RunsStarted, WaveLevelIndex + 1, WaveIndex + 1, *FString::Join(Violations, TEXT(", ")));
+	}
+
+	AppendResultRow(FString::Printf(TEXT("%d,Wave,%d,%d,%s,%d,%.2f,%.2f,%.2f,%d,%.1f,,%s"),
+		RunsStarted, WaveLevelIndex + 1, WaveIndex + 1, Outcome, FrameTimesMs.Num(),
+		P50, P95, P99, HitchCount, PeakMemoryMB, Violations.Num() > 0 ? TEXT("FAIL") : TEXT("OK")));
+}
+
+void USoakRunSubsystem::OnGameOver(bool bAllLevelsCleared)
+{
+	if (bFinished)
+	{
+		return;
+	}
+
+	RunsCompleted++;
+	if (bAllLevelsCleared)
+	{
+		RunsCleared++;
+	}
+	else
+	{
+		// 봇이 시간 안에 코인을 다 못 모은 경우. 성능 예산 위반은 아니므로 기록만 남김
+		UE_LOG(LogSoakRun, Warning, TEXT("Run %d ended before clearing all levels"), RunsStarted);
+	}
+
+	if (RunsCompleted >= RunsRequested)
+	{
+		Finish();
+		return;
+	}
+
+	GetGameInstance()->GetTimerManager().SetTimer(NextRunTimerHandle, this, &USoakRunSubsystem::StartNextRun, 1.0f, false);
+}
+
+void USoakRunSubsystem::OnPreLoadMap(const FString& MapName)
+{
+	bInWave = false;
+	TransitionStartTime = FPlatformTime::Seconds();
+	TransitionMapName = FPaths::GetBaseFilename(MapName);
+}
+
+void USoakRunSubsystem::OnPostLoadMap(UWorld* LoadedWorld)
+{
+	if (TransitionStartTime > 0.0)
+	{
+		const float TransitionSec = static_cast<float>(FPlatformTime::Seconds() - TransitionStartTime);
+		TransitionStartTime = 0.0;
+
+		const bool bOverBudget = TransitionSec > MaxLevelTransitionSec;
+		if (bOverBudget)
+		{
+			BudgetFailures++;
+			UE_LOG(LogSoakRun, Error, TEXT("Level transition to %s took %.2fs (budget %.2fs)"), *TransitionMapName, TransitionSec, MaxLevelTransitionSec);
+		}
+
+		AppendResultRow(FString::Printf(TEXT("%d,Transition,%s,,,,,,,,,%.3f,%s"),
+			RunsStarted, *TransitionMapName, TransitionSec, bOverBudget ? TEXT("FAIL") : TEXT("OK")));
+	}
+
+	// 첫 실행은 메뉴 레벨에서 시작
+	if (RunsStarted == 0 && LoadedWorld && LoadedWorld->GetMapName().Contains("MenuLevel"))
+	{
+		GetGameInstance()->GetTimerManager().SetTimer(NextRunTimerHandle, this, &USoakRunSubsystem::StartNextRun, 1.0f, false);
+	}
+}
+
+void USoakRunSubsystem::StartNextRun()
+{
+	RunsStarted++;
+	UE_LOG(LogSoakRun, Display, TEXT("Starting soak run %d / %d"), RunsStarted, RunsRequested);
+
+	UWorld* World = GetGameInstance()->GetWorld();
+	if (ACH8_UICharacter* PlayerCharacter = Cast<ACH8_UICharacter>(UGameplayStatics::GetPlayerCharacter(World, 0)))
+	{
+		PlayerCharacter->StartGame();
+		return;
+	}
+
+	// 캐릭터가 없는 맵이라면 StartGame 과 동일하게 직접 시작
+	if (UBaseGameInstance* BaseGameInstance = Cast<UBaseGameInstance>(GetGameInstance()))
+	{
+		BaseGameInstance->BeginRun();
+	}
+	UGameplayStatics::OpenLevel(World, FName("BasicLevel"));
+}
+
+void USoakRunSubsystem::Finish()
+{
+	bFinished = true;
+
+	const bool bPassed = BudgetFailures == 0;
+	UE_LOG(LogSoakRun, Display, TEXT("Soak run finished: %d runs, %d cleared all levels, %d budget violations -> %s"),
+		RunsCompleted, RunsCleared, BudgetFailures, bPassed ? TEXT("PASS") : TEXT("FAIL"));
+
+	FPlatformMisc::RequestExitWithStatus(false, bPassed ? 0 : 1);
+}
+
+const FSoakWaveBudget& USoakRunSubsystem::FindBudget(int32 LevelIndex, int32 InWaveIndex) const
+{
+	for (const FSoakWaveBudget& Budget : WaveBudgets)
+	{
+		const bool bLevelMatch = Budget.LevelIndex == INDEX_NONE || Budget.LevelIndex == LevelIndex;
+		const bool bWaveMatch = Budget.WaveIndex == INDEX_NONE || Budget.WaveIndex == InWaveIndex;
+		if (bLevelMatch && bWaveMatch)
+		{
+			return Budget;
+		}
+	}
+	return DefaultWaveBudget;
+}
+
+void USoakRunSubsystem::AppendResultRow(const FString& Row)
+{
+	FFileHelper::SaveStringToFile(Row + LINE_TERMINATOR, *GetResultFilePath(), FFileHelper::EEncodingOptions::ForceUTF8WithoutBOM, &IFileManager::Get(), FILEWRITE_Append);
+}
@@ -0,0 +1,78 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "SpawnGovernorSubsystem.h"
+#include "Engine/World.h"
+#include "RenderCore.h"
+
+DEFINE_LOG_CATEGORY(LogSpawnGovernor);
+
+bool USpawnGovernorSubsystem::ShouldCreateSubsystem(UObject* Outer) const
+{
+	const UWorld* World = Cast<UWorld>(Outer);
+	return World && World->IsGameWorld();
+}
+
+TStatId USpawnGovernorSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(USpawnGovernorSubsystem, STATGROUP_Tickables);
+}
+
+void USpawnGovernorSubsystem::AddSample(float FrameMs)
+{
+	SmoothedFrameMs = SmoothedFrameMs > 0.0f ? FMath::Lerp(SmoothedFrameMs, FrameMs, FrameSmoothing) : FrameMs;
+
+	// 오래된 샘플일수록 가중치가 줄어들도록 누적값을 감쇠
+	const double Decay = FMath::Pow(0.5, 1.0 / FMath::Max(SampleHalfLifeFrames, 1.0f));
+	const double X = LiveItems;
+	const double Y = FrameMs;
+	SumW = SumW * Decay + 1.0;
+	SumX = SumX * Decay + X;
+	SumY = SumY * Decay + Y;
+	SumXX = SumXX * Decay + X * X;
+	SumXY = SumXY * Decay + X * Y;
+}
+
+void USpawnGovernorSubsystem::UpdateCap()
+{
+	const double Denominator = SumW * SumXX - SumX * SumX;
+	// 아이템 수 변화가 충분히 관측되어야 기울기를 믿을 수 있음 (분산 1 미만이면 추정하지 않음)
+	if (SumW > 0.0 && Denominator > SumW * SumW)
+	{
+		CostPerItemMs = FMath::Max(static_cast<float>((SumW * SumXY - SumX * SumY) / Denominator), 0.0f);
+		BaseFrameMs = static_cast<float>((SumY - CostPerItemMs * SumX) / SumW);
+	}
+
+	int32 NewCap = MaxLiveItems;
+	if (CostPerItemMs > UE_KINDA_SMALL_NUMBER)
+	{
+		NewCap = FMath::FloorToInt((TargetFrameMs - BaseFrameMs) / CostPerItemMs);
+	}
+	// 추정과 관계없이 실제 프레임이 예산을 넘고 있으면 지금보다 늘리지 않음
+	if (SmoothedFrameMs > TargetFrameMs)
+	{
+		NewCap = FMath::Min(NewCap, LiveItems);
+	}
+	LiveItemCap = FMath::Clamp(NewCap, MinLiveItems, FMath::Max(MaxLiveItems, MinLiveItems));
+
+	if (FMath::Abs(LiveItemCap - LastLoggedCap) >= CapLogThreshold)
+	{
+		UE_LOG(LogSpawnGovernor, Log, TEXT("Live item cap %d -> %d (%.3f ms/item, base %.2f ms, smoothed %.2f ms, live %d)"),
+			LastLoggedCap, LiveItemCap, CostPerItemMs, BaseFrameMs, SmoothedFrameMs, LiveItems);
+		LastLoggedCap = LiveItemCap;
+	}
+}
+
+void USpawnGovernorSubsystem::Tick(float DeltaTime)
+{
+	AddSample(FPlatformTime::ToMilliseconds(FMath::Max(GGameThreadTime, GRenderThreadTime)));
+	UpdateCap();
+}
+
+int32 USpawnGovernorSubsystem::GetSpawnBudget(bool bWaveStart) const
+{
+	// 첫 프레임 전에 웨이브가 시작되면 아직 한도가 없으므로 최대치로
+	const int32 Cap = LiveItemCap > 0 ? LiveItemCap : FMath::Max(MaxLiveItems, MinLiveItems);
+	const int32 Budget = FMath::Max(Cap - LiveItems, 0);
+	return bWaveStart ? Budget : FMath::Min(Budget, MaxSpawnsPerFrame);
+}
@@ -0,0 +1,414 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "SpawnRecordSubsystem.h"
+#include "BaseGameState.h"
+#include "BaseItem.h"
+#include "ItemEffectSubsystem.h"
+#include "ItemSpawnRow.h"
+#include "SpawnGovernorSubsystem.h"
+#include "SpawnVolume.h"
+#include "GameplayAllocCheck.h"
+#include "Engine/World.h"
+#include "GameFramework/Pawn.h"
+#include "GameFramework/PlayerController.h"
+#include "Misc/MemStack.h"
+#include "WorldPartition/WorldPartition.h"
+#include "WorldPartition/WorldPartitionRuntimeCell.h"
+#include "WorldPartition/WorldPartitionStreamingSource.h"
+#include "WorldPartition/WorldPartitionSubsystem.h"
+
+DEFINE_LOG_CATEGORY(LogSpawnRecords);
+
+bool USpawnRecordSubsystem::ShouldCreateSubsystem(UObject* Outer) const
+{
+	const UWorld* World = Cast<UWorld>(Outer);
+	return World && World->IsGameWorld();
+}
+
+void USpawnRecordSubsystem::OnWorldBeginPlay(UWorld& InWorld)
+{
+	Super::OnWorldBeginPlay(InWorld);
+
+	const UWorldPartition* WorldPartition = InWorld.GetWorldPartition();
+	bUseStreaming = WorldPartition && WorldPartition->IsStreamingEnabled();
+}
+
+TStatId USpawnRecordSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(USpawnRecordSubsystem, STATGROUP_Tickables);
+}
+
+FIntPoint USpawnRecordSubsystem::GetCellCoord(const FVector& Location) const
+{
+	return FIntPoint(FMath::FloorToInt(Location.X / CellSize), FMath::FloorToInt(Location.Y / CellSize));
+}
+
+bool USpawnRecordSubsystem::IsCellLoaded(const FRecordCell& Cell) const
+{
+	if (!bUseStreaming)
+	{
+		return true;
+	}
+
+	const UWorldPartitionSubsystem* WorldPartitionSubsystem = GetWorld()->GetSubsystem<UWorldPartitionSubsystem>();
+	if (!WorldPartitionSubsystem)
+	{
+		return true;
+	}
+
+	// 칸 중심에서 칸 절반 반경 안의 공간 셀이 모두 활성화되어 있는지
+	FWorldPartitionStreamingQuerySource QuerySource;
+	QuerySource.Location = Cell.Center;
+	QuerySource.Radius = CellSize * 0.5f;
+	QuerySource.bSpatialQuery = true;
+	QuerySource.bUseGridLoadingRange = false;
+	return WorldPartitionSubsystem->IsStreamingCompleted(EWorldPartitionRuntimeCellState::Activated, { QuerySource }, false);
+}
+
+void USpawnRecordSubsystem::StartWave(ASpawnVolume* SpawnVolume, TConstArrayView<const FItemSpawnRow*> WaveItems, TConstArrayView<FVector> Locations)
+{
+	Clear();
+	if (!SpawnVolume || !ensure(WaveItems.Num() == Locations.Num()))
+	{
+		return;
+	}
+
+	Volume = SpawnVolume;
+	Records.Reserve(WaveItems.Num());
+
+	bUseProximityRing = SpawnVolume->UsesProximityRing();
+	MaterializeRadiusSquared = FMath::Square(SpawnVolume->GetMaterializeRadius());
+	DematerializeRadiusSquared = FMath::Square(SpawnVolume->GetDematerializeRadius());
+	UItemEffectSubsystem* EffectSubsystem = GetWorld()->GetSubsystem<UItemEffectSubsystem>();
+
+	for (int32 ItemIndex = 0; ItemIndex < WaveItems.Num(); ItemIndex++)
+	{
+		const FItemSpawnRow* Row = WaveItems[ItemIndex];
+		const int32 RecordIndex = Records.AddDefaulted();
+		FItemSpawnRecord& Record = Records[RecordIndex];
+		Record.Row = Row;
+		Record.Location = Locations[ItemIndex];
+		Record.RemainingLifetime = Row->Lifetime;
+		Record.Cell = GetCellCoord(Record.Location);
+		Record.bCountsAsCoin = EffectSubsystem && EffectSubsystem->CountsAsCoin(Row->ItemClass);
+
+		FRecordCell* Cell = Cells.Find(Record.Cell);
+		if (!Cell)
+		{
+			Cell = &Cells.Add(Record.Cell);
+			Cell->Center = FVector((Record.Cell.X + 0.5f) * CellSize, (Record.Cell.Y + 0.5f) * CellSize, Record.Location.Z);
+			Cell->OrderIndex = CellOrder.Add(Record.Cell);
+		}
+		Cell->NumRecords++;
+		Cell->NumPending++;
+	}
+	NumPending = Records.Num();
+
+	// 칸 순서대로 구간을 나눈 뒤 기록 인덱스를 채움. 칸별로 채운 수는 이 함수 안에서만 쓰므로 프레임 스택에
+	int32 FirstRecord = 0;
+	for (const FIntPoint& CellCoord : CellOrder)
+	{
+		FRecordCell& Cell = Cells[CellCoord];
+		Cell.FirstRecord = FirstRecord;
+		FirstRecord += Cell.NumRecords;
+	}
+
+	FMemMark MemMark(FMemStack::Get());
+	TArray<int32, TMemStackAllocator<>> NumFilled;
+	NumFilled.SetNumZeroed(CellOrder.Num());
+
+	CellRecordIndices.SetNumUninitialized(Records.Num(), EAllowShrinking::No);
+	for (int32 RecordIndex = 0; RecordIndex < Records.Num(); RecordIndex++)
+	{
+		const FRecordCell& Cell = Cells[Records[RecordIndex].Cell];
+		CellRecordIndices[Cell.FirstRecord + NumFilled[Cell.OrderIndex]++] = RecordIndex;
+	}
+
+	UpdateCellStates(true);
+	if (bUseProximityRing)
+	{
+		UpdateProximity(0.0f);
+	}
+
+	const USpawnGovernorSubsystem* SpawnGovernor = GetWorld()->GetSubsystem<USpawnGovernorSubsystem>();
+	const int32 Spawned = Materialize(SpawnGovernor ? SpawnGovernor->GetSpawnBudget(true) : MAX_int32);
+
+	UE_LOG(LogSpawnRecords, Log, TEXT("Wave items %d in %d cells: spawned %d, waiting %d (%d cells unloaded)%s"),
+		Records.Num(), Cells.Num(), Spawned, NumPending, NumUnloadedCells, bUseProximityRing ? TEXT(", proximity ring") : TEXT(""));
+}
+
+void USpawnRecordSubsystem::Clear()
+{
+	if (Records.Num() > 0)
+	{
+		UE_LOG(LogSpawnRecords, Log, TEXT("Wave records cleared: peak live %d of %d"), PeakLive, Records.Num());
+	}
+
+	Serial++;
+	Records.Reset();
+	CellRecordIndices.Reset();
+	Cells.Reset();
+	CellOrder.Reset();
+	NextCellToCheck = 0;
+	NumPending = 0;
+	NumUnloadedCells = 0;
+	NumLive = 0;
+	PeakLive = 0;
+	FailedCoins = 0;
+	bUseProximityRing = false;
+	Volume.Reset();
+}
+
+void USpawnRecordSubsystem::UpdateCellStates(bool bAllCells)
+{
+	if (CellOrder.IsEmpty())
+	{
+		return;
+	}
+
+	const int32 NumToCheck = bAllCells ? CellOrder.Num() : FMath::Min(CellsCheckedPerFrame, CellOrder.Num());
+	for (int32 Checked = 0; Checked < NumToCheck; Checked++)
+	{
+		NextCellToCheck = (NextCellToCheck + 1) % CellOrder.Num();
+		FRecordCell& Cell = Cells[CellOrder[NextCellToCheck]];
+
+		const bool bLoaded = IsCellLoaded(Cell);
+		if (bLoaded == Cell.bLoaded && !bAllCells)
+		{
+			continue;
+		}
+
+		if (!bLoaded && Cell.bLoaded)
+		{
+			Dematerialize(Cell);
+		}
+		Cell.bLoaded = bLoaded;
+	}
+
+	NumUnloadedCells = 0;
+	for (const TPair<FIntPoint, FRecordCell>& Pair : Cells)
+	{
+		NumUnloadedCells += Pair.Value.bLoaded ? 0 : 1;
+	}
+}
+
+void USpawnRecordSubsystem::Dematerialize(FRecordCell& Cell)
+{
+	int32 Count = 0;
+	for (const int32 RecordIndex : GetCellRecords(Cell))
+	{
+		if (DematerializeRecord(Records[RecordIndex], Cell))
+		{
+			Count++;
+		}
+	}
+
+	if (Count > 0)
+	{
+		UE_LOG(LogSpawnRecords, Verbose, TEXT("Cell streamed out: %d items returned to records"), Count);
+	}
+}
+
+bool USpawnRecordSubsystem::DematerializeRecord(FItemSpawnRecord& Record, FRecordCell& Cell)
+{
+	ABaseItem* Item = Record.Actor.Get();
+	// 효과가 진행 중인 아이템(터지기 직전의 지뢰 등)은 끝날 때까지 둠
+	if (Record.State != ERecordState::Live || !Item || Item->IsEffectPending())
+	{
+		return false;
+	}
+
+	TGuardValue<bool> DematerializeGuard(bDematerializing, true);
+
+	// 자석 등으로 움직였을 수 있으므로 현재 위치와 남은 수명을 저장
+	Record.Location = Item->GetActorLocation();
+	if (Record.RemainingLifetime > 0.0f)
+	{
+		Record.RemainingLifetime = FMath::Max(Item->GetRemainingLifetime(), UE_KINDA_SMALL_NUMBER);
+	}
+	Record.Actor.Reset();
+	Record.State = ERecordState::Pending;
+	Cell.NumPending++;
+	NumPending++;
+	NumLive--;
+
+	Item->Destroy();
+	return true;
+}
+
+int32 USpawnRecordSubsystem::Materialize(int32 Budget)
+{
+	ASpawnVolume* SpawnVolume = Volume.Get();
+	if (!SpawnVolume || Budget <= 0 || NumPending == 0)
+	{
+		return 0;
+	}
+
+	int32 Spawned = 0;
+	for (const FIntPoint& CellCoord : CellOrder)
+	{
+		FRecordCell& Cell = Cells[CellCoord];
+		if (!Cell.bLoaded || Cell.NumPending == 0)
+		{
+			continue;
+		}
+
+		for (const int32 RecordIndex : GetCellRecords(Cell))
+		{
+			FItemSpawnRecord& Record = Records[RecordIndex];
+			if (Record.State != ERecordState::Pending)
+			{
+				continue;
+			}
+			if (bUseProximityRing && !IsNearPlayer(Record.Location, MaterializeRadiusSquared))
+			{
+				continue;
+			}
+
+			Record.State = ERecordState::Live;
+			Cell.NumPending--;
+			NumPending--;
+
+			ABaseItem* Item = Cast<ABaseItem>(SpawnVolume->SpawnItemFromRow(*Record.Row, Record.Location));
+			if (!Item)
+			{
+				// 스폰 실패한 기록은 다시 시도하지 않음. 코인이면 계획의 코인 수에 들어있으므로 웨이브 완료 조건에서 빼야 함
+				Record.State = ERecordState::Done;
+				FailedCoins += Record.bCountsAsCoin ? 1 : 0;
+				UE_LOG(LogSpawnRecords, Warning, TEXT("Failed to spawn %s from record"), *Record.Row->ItemName.ToString());
+				continue;
+			}
+
+			Item->SetSpawnRecord(RecordIndex, Serial);
+			if (Record.RemainingLifetime > 0.0f)
+			{
+				Item->SetRemainingLifetime(Record.RemainingLifetime);
+			}
+			Record.Actor = Item;
+			NumLive++;
+			PeakLive = FMath::Max(PeakLive, NumLive);
+
+			if (++Spawned >= Budget)
+			{
+				return Spawned;
+			}
+		}
+	}
+	return Spawned;
+}
+
+void USpawnRecordSubsystem::OnItemEndPlay(ABaseItem* Item, int32 RecordIndex, uint32 RecordSerial)
+{
+	if (bDematerializing || RecordSerial != Serial || !Records.IsValidIndex(RecordIndex))
+	{
+		return;
+	}
+
+	FItemSpawnRecord& Record = Records[RecordIndex];
+	if (Record.State == ERecordState::Live && Record.Actor.Get() == Item)
+	{
+		Record.State = ERecordState::Done;
+		Record.Actor.Reset();
+		NumLive--;
+	}
+}
+
+bool USpawnRecordSubsystem::IsNearPlayer(const FVector& Location, float RadiusSquared) const
+{
+	for (const FVector& PlayerLocation : PlayerLocations)
+	{
+		if (FVector::DistSquaredXY(Location, PlayerLocation) <= RadiusSquared)
+		{
+			return true;
+		}
+	}
+	return false;
+}
+
+void USpawnRecordSubsystem::UpdateProximity(float DeltaTime)
+{
+	PlayerLocations.Reset();
+	for (FConstPlayerControllerIterator It = GetWorld()->GetPlayerControllerIterator(); It; ++It)
+	{
+		if (const APawn* Pawn = It->IsValid() ? (*It)->GetPawn() : nullptr)
+		{
+			PlayerLocations.Add(Pawn->GetActorLocation());
+		}
+	}
+
+	int32 ExpiredCoins = 0;
+	int32 Dematerialized = 0;
+	for (FItemSpawnRecord& Record : Records)
+	{
+		if (Record.State == ERecordState::Pending)
+		{
+			// 액터였다면 진행됐을 수명을 기록 상태에서도 진행
+			if (Record.RemainingLifetime > 0.0f && DeltaTime > 0.0f)
+			{
+				Record.RemainingLifetime -= DeltaTime;
+				if (Record.RemainingLifetime <= 0.0f)
+				{
+					Record.State = ERecordState::Done;
+					Cells[Record.Cell].NumPending--;
+					NumPending--;
+					ExpiredCoins += Record.bCountsAsCoin ? 1 : 0;
+				}
+			}
+		}
+		else if (Record.State == ERecordState::Live && PlayerLocations.Num() > 0)
+		{
+			const ABaseItem* Item = Record.Actor.Get();
+			if (Item && !IsNearPlayer(Item->GetActorLocation(), DematerializeRadiusSquared) && DematerializeRecord(Record, Cells[Record.Cell]))
+			{
+				Dematerialized++;
+			}
+		}
+	}
+
+	if (Dematerialized > 0)
+	{
+		UE_LOG(LogSpawnRecords, Verbose, TEXT("Left proximity ring: %d items returned to records"), Dematerialized);
+	}
+
+	// 웨이브 전환을 일으킬 수 있으므로 기록 순회가 끝난 뒤에
+	if (ExpiredCoins > 0)
+	{
+		if (ABaseGameState* GameState = GetWorld()->GetGameState<ABaseGameState>())
+		{
+			GameState->OnCoinsExpired(ExpiredCoins);
+		}
+	}
+}
+
+void USpawnRecordSubsystem::Tick(float DeltaTime)
+{
+	if (Records.IsEmpty())
+	{
+		return;
+	}
+
+	UpdateCellStates(false);
+	if (bUseProximityRing)
+	{
+		UpdateProximity(DeltaTime);
+	}
+
+	if (NumPending > 0)
+	{
+		CH8_ALLOC_SCOPE(Spawn);
+		const USpawnGovernorSubsystem* SpawnGovernor = GetWorld()->GetSubsystem<USpawnGovernorSubsystem>();
+		Materialize(SpawnGovernor ? SpawnGovernor->GetSpawnBudget(false) : MAX_int32);
+	}
+
+	// 웨이브 시작 중의 실패도 여기서 알림 (그때는 아직 웨이브 규칙이 이번 웨이브 코인 수로 시작되기 전)
+	if (FailedCoins > 0)
+	{
+		const int32 Count = FailedCoins;
+		FailedCoins = 0;
+		if (ABaseGameState* GameState = GetWorld()->GetGameState<ABaseGameState>())
+		{
+			GameState->OnCoinsExpired(Count);
+		}
+	}
+}
@@ -0,0 +1,154 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "SpawnRegionSampler.h"
+#include "Algo/BinarySearch.h"
+#include "Math/RandomStream.h"
+
+namespace
+{
+	double CrossXY(const FVector& Origin, const FVector& A, const FVector& B)
+	{
+		return (A.X - Origin.X) * (B.Y - Origin.Y) - (A.Y - Origin.Y) * (B.X - Origin.X);
+	}
+
+	// 반시계 방향 삼각형 ABC 안(경계 포함)에 P 가 있는지 (XY)
+	bool IsInsideTriangleXY(const FVector& P, const FVector& A, const FVector& B, const FVector& C)
+	{
+		return CrossXY(A, B, P) >= 0.0 && CrossXY(B, C, P) >= 0.0 && CrossXY(C, A, P) >= 0.0;
+	}
+}
+
+void FSpawnRegionSampler::Reset()
+{
+	Corners.Reset();
+	CumulativeArea.Reset();
+	Bounds = FBox(ForceInit);
+}
+
+void FSpawnRegionSampler::AddTriangle(const FVector& A, const FVector& B, const FVector& C)
+{
+	// 경사면도 실제 표면 넓이만큼 뽑히도록 3D 넓이 사용
+	const double Area = 0.5 * FVector::CrossProduct(B - A, C - A).Size();
+	if (Area <= UE_KINDA_SMALL_NUMBER)
+	{
+		return;
+	}
+
+	Corners.Add(A);
+	Corners.Add(B);
+	Corners.Add(C);
+	CumulativeArea.Add(GetTotalArea() + Area);
+	Bounds += A;
+	Bounds += B;
+	Bounds += C;
+}
+
+bool FSpawnRegionSampler::AddPolygon(TArrayView<const FVector> Points)
+{
+	if (Points.Num() < 3)
+	{
+		return false;
+	}
+
+	// 부호 있는 넓이로 감은 방향 판별
+	double SignedArea = 0.0;
+	for (int32 Index = 0; Index < Points.Num(); Index++)
+	{
+		const FVector& A = Points[Index];
+		const FVector& B = Points[(Index + 1) % Points.Num()];
+		SignedArea += A.X * B.Y - B.X * A.Y;
+	}
+
+	// 반시계 방향 순서의 남은 꼭짓점 인덱스
+	TArray<int32, TInlineAllocator<64>> Remaining;
+	Remaining.Reserve(Points.Num());
+	for (int32 Index = 0; Index < Points.Num(); Index++)
+	{
+		Remaining.Add(SignedArea >= 0.0 ? Index : Points.Num() - 1 - Index);
+	}
+
+	while (Remaining.Num() > 3)
+	{
+		bool bClipped = false;
+		for (int32 Index = 0; Index < Remaining.Num(); Index++)
+		{
+			const int32 Prev = Remaining[(Index + Remaining.Num() - 1) % Remaining.Num()];
+			const int32 Curr = Remaining[Index];
+			const int32 Next = Remaining[(Index + 1) % Remaining.Num()];
+			const double Cross = CrossXY(Points[Prev], Points[Curr], Points[Next]);
+
+			// 일직선 위의 꼭짓점은 넓이 없이 그냥 제거
+			if (FMath::Abs(Cross) <= UE_KINDA_SMALL_NUMBER)
+			{
+				Remaining.RemoveAt(Index);
+				bClipped = true;
+				break;
+			}
+			if (Cross < 0.0)
+			{
+				continue;
+			}
+
+			// 다른 꼭짓점이 안에 들어있지 않은 볼록 꼭짓점이 귀
+			bool bIsEar = true;
+			for (const int32 Other : Remaining)
+			{
+				if (Other != Prev && Other != Curr && Other != Next && IsInsideTriangleXY(Points[Other], Points[Prev], Points[Curr], Points[Next]))
+				{
+					bIsEar = false;
+					break;
+				}
+			}
+			if (bIsEar)
+			{
+				AddTriangle(Points[Prev], Points[Curr], Points[Next]);
+				Remaining.RemoveAt(Index);
+				bClipped = true;
+				break;
+			}
+		}
+
+		// 자기 교차 다각형은 귀가 없어질 수 있음
+		if (!bClipped)
+		{
+			return false;
+		}
+	}
+
+	if (Remaining.Num() == 3)
+	{
+		AddTriangle(Points[Remaining[0]], Points[Remaining[1]], Points[Remaining[2]]);
+	}
+	return true;
+}
+
+FVector FSpawnRegionSampler::GetRandomPoint() const
+{
+	return SampleAt(FMath::FRand(), FMath::FRand(), FMath::FRand(), FMath::FRand());
+}
+
+FVector FSpawnRegionSampler::GetRandomPoint(FRandomStream& Stream) const
+{
+	return SampleAt(Stream.FRand(), Stream.FRand(), Stream.FRand(), Stream.FRand());
+}
+
+FVector FSpawnRegionSampler::SampleAt(float TriangleRand, float U, float V, float HeightRand) const
+{
+	if (CumulativeArea.IsEmpty())
+	{
+		return FVector::ZeroVector;
+	}
+
+	// 누적 면적이 처음으로 난수를 넘는 삼각형
+	const int32 Triangle = FMath::Min(Algo::UpperBound(CumulativeArea, TriangleRand * CumulativeArea.Last()), CumulativeArea.Num() - 1);
+	const FVector& A = Corners[Triangle * 3];
+	const FVector& B = Corners[Triangle * 3 + 1];
+	const FVector& C = Corners[Triangle * 3 + 2];
+
+	// 제곱근 변환으로 삼각형 안에서 균일한 무게중심 좌표
+	const float SqrtU = FMath::Sqrt(U);
+	FVector Point = A * (1.0f - SqrtU) + B * (SqrtU * (1.0f - V)) + C * (SqrtU * V);
+	Point.Z += HeightRand * Height;
+	return Point;
+}
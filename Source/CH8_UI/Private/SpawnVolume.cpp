@@ -1,6 +1,20 @@
 #include "SpawnVolume.h"
+#include "BaseItem.h"
+#include "GameplayEventSubsystem.h"
+#include "GameplayAllocCheck.h"
+#include "GameplayLLMTags.h"
 #include "Components/BoxComponent.h"
+#include "Components/SplineComponent.h"
 #include "Engine/World.h"
+#include "EngineUtils.h"
+#include "GameFramework/PlayerStart.h"
+#include "NavigationSystem.h"
+#include "NavigationData.h"
+#if WITH_RECAST
+#include "NavMesh/RecastNavMesh.h"
+#endif
+
+DEFINE_LOG_CATEGORY(LogSpawnVolume);
 
 ASpawnVolume::ASpawnVolume()
 {
@@ -12,20 +26,47 @@ ASpawnVolume::ASpawnVolume()
     SpawningBox = CreateDefaultSubobject<UBoxComponent>(TEXT("SpawningBox"));
     SpawningBox->SetupAttachment(Scene);
 
+    SpawningSpline = CreateDefaultSubobject<USplineComponent>(TEXT("SpawningSpline"));
+    SpawningSpline->SetupAttachment(Scene);
+
     ItemDataTable = nullptr;
+
+#if WITH_EDITORONLY_DATA
+    // 볼륨이 넓은 월드 파티션 맵에서도 항상 로드되어 있어야 웨이브를 시작할 수 있음
+    // (볼륨 안의 아이템은 USpawnRecordSubsystem 이 스트리밍 셀에 맞춰 스폰)
+    bIsSpatiallyLoaded = false;
+#endif
 }
 
 AActor* ASpawnVolume::SpawnRandomItem()
 {
     if (FItemSpawnRow* SelectedRow = GetRandomItem())
     {
-        if (UClass* ActualClass = SelectedRow->ItemClass.Get())
+        return SpawnItemFromRow(*SelectedRow);
+    }
+		
+    return nullptr;
+}
+
+AActor* ASpawnVolume::SpawnItemFromRow(const FItemSpawnRow& Row)
+{
+    return SpawnItemFromRow(Row, GetRandomPointInVolume());
+}
+
+AActor* ASpawnVolume::SpawnItemFromRow(const FItemSpawnRow& Row, const FVector& Location)
+{
+    if (UClass* ActualClass = Row.ItemClass.Get())
+    {
+        // 여기서 SpawnItem()을 호출하고, 스폰된 AActor 포인터를 리턴
+        AActor* SpawnedActor = SpawnItem(ActualClass, Location);
+        if (ABaseItem* SpawnedItem = Cast<ABaseItem>(SpawnedActor))
         {
-            // 여기서 SpawnItem()을 호출하고, 스폰된 AActor 포인터를 리턴
-            return SpawnItem(ActualClass);
+            SpawnedItem->ApplySpawnRow(Row);
         }
+        UGameplayEventSubsystem::Record(this, EGameplayEventType::Spawn, 0, 0, 0.0f, Row.ItemName);
+        return SpawnedActor;
     }
-		
+
     return nullptr;
 }
 
@@ -33,27 +74,26 @@ FItemSpawnRow* ASpawnVolume::GetRandomItem() const
 {
     if (!ItemDataTable) return nullptr;
 
-    TArray<FItemSpawnRow*> AllRows;
-    static const FString ContextString(TEXT("ItemSpawnContext"));
-    ItemDataTable->GetAllRows(ContextString, AllRows);
+    const UScriptStruct* RowStruct = ItemDataTable->GetRowStruct();
+    if (!RowStruct || !RowStruct->IsChildOf(FItemSpawnRow::StaticStruct())) return nullptr;
 
-    if (AllRows.IsEmpty()) return nullptr;
+    // GetAllRows 는 호출마다 배열을 새로 만들므로 행 맵을 직접 두 번 순회 (아이템마다 불리는 경로라 할당 없이)
+    const TMap<FName, uint8*>& RowMap = ItemDataTable->GetRowMap();
+    if (RowMap.IsEmpty()) return nullptr;
 
     float TotalChance = 0.0f;
-    for (const FItemSpawnRow* Row : AllRows)
+    for (const TPair<FName, uint8*>& RowPair : RowMap)
     {
-        if (Row)
-        {
-            TotalChance += Row->SpawnChance;
-        }
+        TotalChance += reinterpret_cast<const FItemSpawnRow*>(RowPair.Value)->SpawnChance;
     }
 
     const float RandValue = FMath::FRandRange(0.0f, TotalChance);
 	
     float AccumulateChance = 0.0f;
 
-    for (FItemSpawnRow* Row : AllRows)
+    for (const TPair<FName, uint8*>& RowPair : RowMap)
     {
+        FItemSpawnRow* Row = reinterpret_cast<FItemSpawnRow*>(RowPair.Value);
         AccumulateChance += Row->SpawnChance;
         if (RandValue <= AccumulateChance)
         {
@@ -64,7 +104,300 @@ FItemSpawnRow* ASpawnVolume::GetRandomItem() const
     return nullptr;
 }
 
+void ASpawnVolume::BeginPlay()
+{
+    Super::BeginPlay();
+
+    UNavigationSystemV1* NavSys = FNavigationSystem::GetCurrent<UNavigationSystemV1>(GetWorld());
+    const bool bNavigationReady = NavSys && !NavSys->IsNavigationBuildInProgress();
+
+    // 내비메시 영역은 빌드 중이면 끝난 뒤에 만듦 (그 전까지는 상자에서 뽑음)
+    if (RegionShape != ESpawnRegionShape::NavMesh || bNavigationReady)
+    {
+        BuildSpawnRegion();
+    }
+
+    if (!NavSys || (!bValidateReachability && RegionShape != ESpawnRegionShape::NavMesh))
+    {
+        return;
+    }
+
+    // 런타임 내비메시 재빌드가 끝나면 캐시를 버리고 다시 검증
+    NavSys->OnNavigationGenerationFinishedDelegate.AddUniqueDynamic(this, &ASpawnVolume::OnNavigationGenerationFinished);
+
+    if (bValidateReachability && bNavigationReady)
+    {
+        StartReachabilityValidation();
+    }
+}
+
+void ASpawnVolume::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+    if (UNavigationSystemV1* NavSys = FNavigationSystem::GetCurrent<UNavigationSystemV1>(GetWorld()))
+    {
+        NavSys->OnNavigationGenerationFinishedDelegate.RemoveDynamic(this, &ASpawnVolume::OnNavigationGenerationFinished);
+    }
+    PendingQueries.Reset();
+
+    Super::EndPlay(EndPlayReason);
+}
+
+void ASpawnVolume::OnNavigationGenerationFinished(ANavigationData* NavData)
+{
+    if (RegionShape == ESpawnRegionShape::NavMesh)
+    {
+        BuildSpawnRegion();
+    }
+
+    if (bValidateReachability)
+    {
+        UE_LOG(LogSpawnVolume, Log, TEXT("%s: navigation rebuilt, revalidating spawn points"), *GetName());
+        StartReachabilityValidation();
+    }
+}
+
+void ASpawnVolume::BuildSpawnRegion()
+{
+    if (RegionShape == ESpawnRegionShape::Box)
+    {
+        SpawnRegion.Reset();
+        return;
+    }
+
+    const double StartTime = FPlatformTime::Seconds();
+
+    // 태스크가 이전 영역을 읽고 있을 수 있으므로 고치지 않고 새로 만들어 교체
+    TSharedRef<FSpawnRegionSampler> Region = MakeShared<FSpawnRegionSampler>();
+    Region->SetHeight(RegionHeight);
+
+    switch (RegionShape)
+    {
+    case ESpawnRegionShape::Spline:
+    {
+        // 일정 간격으로 스플라인 양옆 점을 잡아 사각형 띠(삼각형 2개씩)로 나눔
+        const float SplineLength = SpawningSpline->GetSplineLength();
+        const int32 NumSegments = FMath::Max(FMath::CeilToInt(SplineLength / SplineSampleSpacing), 1);
+        FVector PrevLeft = FVector::ZeroVector;
+        FVector PrevRight = FVector::ZeroVector;
+        for (int32 Sample = 0; Sample <= NumSegments; Sample++)
+        {
+            const float Distance = SplineLength * Sample / NumSegments;
+            const FVector Center = SpawningSpline->GetLocationAtDistanceAlongSpline(Distance, ESplineCoordinateSpace::World);
+            const FVector Right = SpawningSpline->GetRightVectorAtDistanceAlongSpline(Distance, ESplineCoordinateSpace::World);
+            const float HalfWidth = 0.5f * SplineWidth * SpawningSpline->GetScaleAtDistanceAlongSpline(Distance).Y;
+            const FVector Left = Center - Right * HalfWidth;
+            const FVector RightEdge = Center + Right * HalfWidth;
+            if (Sample > 0)
+            {
+                Region->AddTriangle(PrevLeft, PrevRight, RightEdge);
+                Region->AddTriangle(PrevLeft, RightEdge, Left);
+            }
+            PrevLeft = Left;
+            PrevRight = RightEdge;
+        }
+        break;
+    }
+
+    case ESpawnRegionShape::Polygon:
+    {
+        TArray<FVector, TInlineAllocator<64>> WorldPoints;
+        WorldPoints.Reserve(PolygonPoints.Num());
+        const FTransform& ActorTransform = GetActorTransform();
+        for (const FVector& Point : PolygonPoints)
+        {
+            WorldPoints.Add(ActorTransform.TransformPosition(Point));
+        }
+        if (!Region->AddPolygon(WorldPoints))
+        {
+            UE_LOG(LogSpawnVolume, Warning, TEXT("%s: spawn polygon with %d points is not a simple polygon, only part of it is used"),
+                *GetName(), PolygonPoints.Num());
+        }
+        break;
+    }
+
+    case ESpawnRegionShape::NavMesh:
+    {
+#if WITH_RECAST
+        // 상자와 겹치는 내비메시 폴리곤을 부채꼴로 나눔 (중심이 상자 밖인 폴리곤은 제외)
+        UNavigationSystemV1* NavSys = FNavigationSystem::GetCurrent<UNavigationSystemV1>(GetWorld());
+        const ARecastNavMesh* NavMesh = NavSys ? Cast<ARecastNavMesh>(NavSys->GetDefaultNavDataInstance(FNavigationSystem::DontCreate)) : nullptr;
+        if (NavMesh)
+        {
+            const FBox SpawnBounds = SpawningBox->Bounds.GetBox();
+            TArray<FNavPoly> Polys;
+            NavMesh->GetPolysInBox(SpawnBounds, Polys);
+
+            TArray<FVector> PolyVerts;
+            for (const FNavPoly& Poly : Polys)
+            {
+                if (!SpawnBounds.IsInsideOrOn(Poly.Center))
+                {
+                    continue;
+                }
+
+                PolyVerts.Reset();
+                if (NavMesh->GetPolyVerts(Poly.Ref, PolyVerts))
+                {
+                    for (int32 Vert = 2; Vert < PolyVerts.Num(); Vert++)
+                    {
+                        Region->AddTriangle(PolyVerts[0], PolyVerts[Vert - 1], PolyVerts[Vert]);
+                    }
+                }
+            }
+        }
+#endif
+        break;
+    }
+
+    default:
+        break;
+    }
+
+    LastRegionBuildMs = (FPlatformTime::Seconds() - StartTime) * 1000.0;
+    if (Region->IsEmpty())
+    {
+        UE_LOG(LogSpawnVolume, Warning, TEXT("%s: spawn region is empty, falling back to the spawning box"), *GetName());
+        SpawnRegion.Reset();
+        return;
+    }
+
+    UE_LOG(LogSpawnVolume, Log, TEXT("%s: spawn region built with %d triangles, %.0f m2, %.2f ms"),
+        *GetName(), Region->GetNumTriangles(), Region->GetTotalArea() / 10000.0, LastRegionBuildMs);
+    SpawnRegion = Region;
+}
+
+void ASpawnVolume::StartReachabilityValidation()
+{
+    UNavigationSystemV1* NavSys = FNavigationSystem::GetCurrent<UNavigationSystemV1>(GetWorld());
+    const ANavigationData* NavData = NavSys ? NavSys->GetDefaultNavDataInstance(FNavigationSystem::DontCreate) : nullptr;
+    if (!NavData)
+    {
+        return;
+    }
+
+    // 진행 중이던 검증 결과는 버림 (늦게 도착한 콜백은 PendingQueries 에 없어서 무시됨)
+    PendingQueries.Reset();
+    ValidatingPoints.Reset();
+    ValidationRejects = 0;
+    ValidationStartTime = FPlatformTime::Seconds();
+
+    // 기준점: 플레이어 시작 지점
+    FVector StartLocation = GetActorLocation();
+    if (TActorIterator<APlayerStart> It(GetWorld()); It)
+    {
+        StartLocation = It->GetActorLocation();
+    }
+
+    FNavLocation StartNavLocation;
+    if (!NavSys->ProjectPointToNavigation(StartLocation, StartNavLocation, ProjectionExtent, NavData))
+    {
+        UE_LOG(LogSpawnVolume, Warning, TEXT("%s: player start is not on the navmesh, spawn points are not validated"), *GetName());
+        return;
+    }
+
+    const FSharedConstNavQueryFilter QueryFilter = NavData->GetDefaultQueryFilter();
+
+    for (int32 Index = 0; Index < CandidateCount; Index++)
+    {
+        const FVector Candidate = GetRandomPointInRegion();
+
+        // 내비메시 밖(지형 속, 공중의 닿지 않는 곳)은 바로 제외
+        FNavLocation CandidateNavLocation;
+        if (!NavSys->ProjectPointToNavigation(Candidate, CandidateNavLocation, ProjectionExtent, NavData))
+        {
+            ValidationRejects++;
+            continue;
+        }
+
+        // 점프로 닿는 높이까지만 원래 높이 유지
+        FVector SpawnPoint = CandidateNavLocation.Location;
+        SpawnPoint.Z += FMath::Clamp(Candidate.Z - CandidateNavLocation.Location.Z, 0.0f, MaxHeightAboveNavMesh);
+
+        FPathFindingQuery Query(this, *NavData, StartNavLocation.Location, CandidateNavLocation.Location, QueryFilter);
+        const uint32 QueryId = NavSys->FindPathAsync(NavData->GetConfig(), Query,
+            FNavPathQueryDelegate::CreateUObject(this, &ASpawnVolume::OnCandidatePathFound), EPathFindingMode::Regular);
+        if (QueryId == INVALID_NAVQUERYID)
+        {
+            ValidationRejects++;
+            continue;
+        }
+        PendingQueries.Add(QueryId, SpawnPoint);
+    }
+
+    if (PendingQueries.IsEmpty())
+    {
+        FinishValidation();
+    }
+}
+
+void ASpawnVolume::OnCandidatePathFound(uint32 QueryId, ENavigationQueryResult::Type Result, FNavPathSharedPtr Path)
+{
+    FVector SpawnPoint;
+    if (!PendingQueries.RemoveAndCopyValue(QueryId, SpawnPoint))
+    {
+        return;
+    }
+
+    // 부분 경로는 목적지 근처까지만 가는 경로이므로 도달 불가로 봄
+    if (Result == ENavigationQueryResult::Success && Path.IsValid() && !Path->IsPartial())
+    {
+        ValidatingPoints.Add(SpawnPoint);
+    }
+    else
+    {
+        ValidationRejects++;
+    }
+
+    if (PendingQueries.IsEmpty())
+    {
+        FinishValidation();
+    }
+}
+
+void ASpawnVolume::FinishValidation()
+{
+    LastValidationMs = (FPlatformTime::Seconds() - ValidationStartTime) * 1000.0;
+    NumRejectedPoints = ValidationRejects;
+    ReachablePoints = MoveTemp(ValidatingPoints);
+    ReachablePointOrder.Reset();
+    ValidatingPoints.Reset();
+
+    UE_LOG(LogSpawnVolume, Log, TEXT("%s: %d of %d spawn candidates reachable, %d rejected, %.2f ms"),
+        *GetName(), ReachablePoints.Num(), CandidateCount, NumRejectedPoints, LastValidationMs);
+}
+
 FVector ASpawnVolume::GetRandomPointInVolume() const
+{
+    const int32 NumPoints = ReachablePoints.Num();
+    if (NumPoints > 0)
+    {
+        // 연달아 스폰할 때 같은 지점이 겹치지 않도록 비복원 추출 (부분 Fisher-Yates)
+        if (ReachablePointOrder.Num() != NumPoints)
+        {
+            ReachablePointOrder.SetNumUninitialized(NumPoints);
+            for (int32 Index = 0; Index < NumPoints; Index++)
+            {
+                ReachablePointOrder[Index] = Index;
+            }
+            NextReachablePoint = 0;
+        }
+        if (NextReachablePoint >= NumPoints)
+        {
+            NextReachablePoint = 0;
+        }
+        ReachablePointOrder.Swap(NextReachablePoint, NextReachablePoint + FMath::RandHelper(NumPoints - NextReachablePoint));
+        return ReachablePoints[ReachablePointOrder[NextReachablePoint++]];
+    }
+
+    return GetRandomPointInRegion();
+}
+
+FVector ASpawnVolume::GetRandomPointInRegion() const
+{
+    return SpawnRegion ? SpawnRegion->GetRandomPoint() : GetRandomPointInBox();
+}
+
+FVector ASpawnVolume::GetRandomPointInBox() const
 {
     FVector BoxExtent = SpawningBox->GetScaledBoxExtent();
     FVector BoxOrigin = SpawningBox->GetComponentLocation();
@@ -76,14 +409,24 @@ FVector ASpawnVolume::GetRandomPointInVolume() const
     );
 }
 
-AActor* ASpawnVolume::SpawnItem(TSubclassOf<AActor> ItemClass)
+void ASpawnVolume::GetSpawnBox(FVector& OutOrigin, FVector& OutExtent) const
+{
+    OutOrigin = SpawningBox->GetComponentLocation();
+    OutExtent = SpawningBox->GetScaledBoxExtent();
+}
+
+AActor* ASpawnVolume::SpawnItem(TSubclassOf<AActor> ItemClass, const FVector& Location)
 {
     if (!ItemClass) return nullptr;
+
+    LLM_SCOPE_BYTAG(CH8Items);
+    // 액터 생성 자체의 할당은 할당 검사에서 제외
+    CH8_ALLOC_ALLOW();
 	
     // SpawnActor가 성공하면 스폰된 액터의 포인터가 반환됨
     AActor* SpawnedActor = GetWorld()->SpawnActor<AActor>(
             ItemClass,
-            GetRandomPointInVolume(),
+            Location,
             FRotator::ZeroRotator
     );
 		
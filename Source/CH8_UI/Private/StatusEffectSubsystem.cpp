@@ -0,0 +1,232 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "StatusEffectSubsystem.h"
+#include "CH8_UI/CH8_UICharacter.h"
+#include "Engine/World.h"
+#include "GameFramework/CharacterMovementComponent.h"
+#include "GameFramework/DamageType.h"
+#include "Kismet/GameplayStatics.h"
+
+bool UStatusEffectSubsystem::ShouldCreateSubsystem(UObject* Outer) const
+{
+	const UWorld* World = Cast<UWorld>(Outer);
+	return World && World->IsGameWorld();
+}
+
+void UStatusEffectSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	// 획득 경로에서 배열이 자라지 않도록 미리 확보
+	for (FStatusEffectArrays& Arrays : Effects)
+	{
+		Arrays.Targets.Reserve(64);
+		Arrays.Magnitudes.Reserve(64);
+		Arrays.RemainingTimes.Reserve(64);
+	}
+}
+
+TStatId UStatusEffectSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UStatusEffectSubsystem, STATGROUP_Tickables);
+}
+
+bool UStatusEffectSubsystem::IsStatusEffect(EItemEffectType EffectType)
+{
+	return GetKind(EffectType) != NumKinds;
+}
+
+UStatusEffectSubsystem::EStatusKind UStatusEffectSubsystem::GetKind(EItemEffectType EffectType)
+{
+	switch (EffectType)
+	{
+	case EItemEffectType::Regeneration:		return Regeneration;
+	case EItemEffectType::SpeedBoost:		return SpeedBoost;
+	case EItemEffectType::ScoreMultiplier:	return ScoreMultiplier;
+	case EItemEffectType::Poison:			return Poison;
+	default:								return NumKinds;
+	}
+}
+
+int32 UStatusEffectSubsystem::FindOrAddTarget(ACH8_UICharacter* Character)
+{
+	for (int32 TargetIndex = 0; TargetIndex < StatusTargets.Num(); TargetIndex++)
+	{
+		if (StatusTargets[TargetIndex].Character == Character)
+		{
+			return TargetIndex;
+		}
+	}
+
+	// 항목에는 대상 인덱스를 1바이트로 저장
+	if (StatusTargets.Num() > MAX_uint8)
+	{
+		return INDEX_NONE;
+	}
+
+	FStatusTarget& Target = StatusTargets.AddDefaulted_GetRef();
+	Target.Character = Character;
+	Target.BaseWalkSpeed = Character->GetCharacterMovement()->MaxWalkSpeed;
+	return StatusTargets.Num() - 1;
+}
+
+void UStatusEffectSubsystem::AddEffect(EItemEffectType EffectType, ACH8_UICharacter* Target, float Magnitude, float Duration)
+{
+	const EStatusKind Kind = GetKind(EffectType);
+	if (Kind == NumKinds || !Target || Target->IsDead() || Duration <= 0.0f)
+	{
+		return;
+	}
+
+	const int32 TargetIndex = FindOrAddTarget(Target);
+	if (TargetIndex == INDEX_NONE)
+	{
+		return;
+	}
+
+	FStatusEffectArrays& Arrays = Effects[Kind];
+	Arrays.Targets.Add(static_cast<uint8>(TargetIndex));
+	Arrays.Magnitudes.Add(Magnitude);
+	Arrays.RemainingTimes.Add(Duration);
+}
+
+float UStatusEffectSubsystem::GetScoreMultiplier(const AActor* Target) const
+{
+	for (const FStatusTarget& StatusTarget : StatusTargets)
+	{
+		if (StatusTarget.Character.Get() == Target)
+		{
+			return 1.0f + StatusTarget.ScoreBonus;
+		}
+	}
+	return 1.0f;
+}
+
+int32 UStatusEffectSubsystem::GetNumActiveEffects() const
+{
+	int32 NumActive = 0;
+	for (const FStatusEffectArrays& Arrays : Effects)
+	{
+		NumActive += Arrays.Targets.Num();
+	}
+	return NumActive;
+}
+
+void UStatusEffectSubsystem::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	if (StatusTargets.IsEmpty())
+	{
+		return;
+	}
+
+	for (FStatusTarget& Target : StatusTargets)
+	{
+		Target.SpeedBonus = 0.0f;
+		Target.ScoreBonus = 0.0f;
+	}
+
+	for (int32 Kind = 0; Kind < NumKinds; Kind++)
+	{
+		AdvanceEffects(static_cast<EStatusKind>(Kind), DeltaTime);
+	}
+
+	ApplyToTargets();
+}
+
+void UStatusEffectSubsystem::AdvanceEffects(EStatusKind Kind, float DeltaTime)
+{
+	FStatusEffectArrays& Arrays = Effects[Kind];
+	const int32 NumEffects = Arrays.Targets.Num();
+	if (NumEffects == 0)
+	{
+		return;
+	}
+
+	// 재생/독은 초당 체력 변화를 이번 프레임에 남아있던 시간만큼 누적, 속도/점수는 아직 남은 효과의 세기를 합산
+	const bool bPerSecond = Kind == Regeneration || Kind == Poison;
+	const float Sign = Kind == Poison ? -1.0f : 1.0f;
+	float FStatusTarget::* const Sum = bPerSecond ? &FStatusTarget::PendingHealth
+		: Kind == SpeedBoost ? &FStatusTarget::SpeedBonus : &FStatusTarget::ScoreBonus;
+
+	uint8* Targets = Arrays.Targets.GetData();
+	float* Magnitudes = Arrays.Magnitudes.GetData();
+	float* RemainingTimes = Arrays.RemainingTimes.GetData();
+
+	// 남는 항목을 앞으로 당겨 채우고 끝을 잘라냄 (배열 크기만 줄이므로 할당 없음)
+	int32 NumKept = 0;
+	for (int32 Index = 0; Index < NumEffects; Index++)
+	{
+		FStatusTarget& Target = StatusTargets[Targets[Index]];
+		const float Remaining = RemainingTimes[Index] - DeltaTime;
+
+		if (bPerSecond)
+		{
+			Target.*Sum += Sign * Magnitudes[Index] * FMath::Min(DeltaTime, RemainingTimes[Index]);
+		}
+		else if (Remaining > 0.0f)
+		{
+			Target.*Sum += Magnitudes[Index];
+		}
+
+		// 대상이 사라지거나 죽으면 남은 효과도 제거
+		const ACH8_UICharacter* Character = Target.Character.Get();
+		if (Remaining > 0.0f && Character && !Character->IsDead())
+		{
+			Targets[NumKept] = Targets[Index];
+			Magnitudes[NumKept] = Magnitudes[Index];
+			RemainingTimes[NumKept] = Remaining;
+			NumKept++;
+		}
+	}
+
+	Arrays.Targets.SetNum(NumKept, EAllowShrinking::No);
+	Arrays.Magnitudes.SetNum(NumKept, EAllowShrinking::No);
+	Arrays.RemainingTimes.SetNum(NumKept, EAllowShrinking::No);
+}
+
+void UStatusEffectSubsystem::ApplyToTargets()
+{
+	for (FStatusTarget& Target : StatusTargets)
+	{
+		ACH8_UICharacter* Character = Target.Character.Get();
+		if (!Character)
+		{
+			continue;
+		}
+
+		// 죽은 뒤에는 체력을 바꾸지 않음 (데미지마다 사망 처리가 다시 불리지 않도록)
+		if (Character->IsDead())
+		{
+			Target.PendingHealth = 0.0f;
+			continue;
+		}
+
+		// 속도는 합계가 바뀐 프레임에만 (마지막 효과가 끝나면 원래 속도로)
+		if (Target.SpeedBonus != Target.AppliedSpeedBonus)
+		{
+			Character->GetCharacterMovement()->MaxWalkSpeed = Target.BaseWalkSpeed * FMath::Max(1.0f + Target.SpeedBonus, 0.0f);
+			Target.AppliedSpeedBonus = Target.SpeedBonus;
+		}
+
+		// 체력은 1 단위로 모아서 적용 (매 프레임 체력 문구와 이벤트를 만들지 않도록)
+		const float WholeHealth = FMath::TruncToFloat(Target.PendingHealth);
+		if (WholeHealth == 0.0f)
+		{
+			continue;
+		}
+		Target.PendingHealth -= WholeHealth;
+
+		if (WholeHealth > 0.0f)
+		{
+			Character->AddHealth(WholeHealth);
+		}
+		else
+		{
+			// 독으로 체력이 0 이 되면 TakeDamage 가 게임 오버까지 처리
+			UGameplayStatics::ApplyDamage(Character, -WholeHealth, nullptr, nullptr, UDamageType::StaticClass());
+		}
+	}
+}
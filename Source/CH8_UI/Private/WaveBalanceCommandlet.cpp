@@ -0,0 +1,246 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "WaveBalanceCommandlet.h"
+#include "WaveBalanceSimulation.h"
+#include "BaseGameState.h"
+#include "BaseItem.h"
+#include "GameplayStatistics.h"
+#include "ItemEffectSubsystem.h"
+#include "ItemEffectTypes.h"
+#include "ItemSpawnRow.h"
+#include "Engine/DataTable.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+
+namespace
+{
+	void ParseList(const FString& Params, const TCHAR* Key, TArray<float>& OutValues)
+	{
+		FString ListString;
+		if (!FParse::Value(*Params, Key, ListString, false))
+		{
+			return;
+		}
+
+		TArray<FString> Parts;
+		ListString.ParseIntoArray(Parts, TEXT(","));
+		OutValues.Reset();
+		for (const FString& Part : Parts)
+		{
+			OutValues.Add(FCString::Atof(*Part));
+		}
+	}
+}
+
+UWaveBalanceCommandlet::UWaveBalanceCommandlet()
+{
+	IsClient = false;
+	IsServer = false;
+	IsEditor = false;
+	LogToConsole = true;
+}
+
+bool UWaveBalanceCommandlet::BuildLevelItemMix(const UDataTable& SpawnTable, const UDataTable* EffectTable, FSimLevelItemMix& OutMix) const
+{
+	static const FString ContextString(TEXT("WaveBalanceContext"));
+	TArray<FItemSpawnRow*> Rows;
+	SpawnTable.GetAllRows(ContextString, Rows);
+
+	float TotalChance = 0.0f;
+	for (const FItemSpawnRow* Row : Rows)
+	{
+		if (Row)
+		{
+			TotalChance += Row->SpawnChance;
+		}
+	}
+	if (TotalChance <= 0.0f)
+	{
+		return false;
+	}
+
+	float CoinScoreSum = 0.0f;
+	float MineDamageSum = 0.0f;
+	float HealAmountSum = 0.0f;
+
+	for (const FItemSpawnRow* Row : Rows)
+	{
+		const ABaseItem* Prototype = Row && Row->ItemClass ? Row->ItemClass->GetDefaultObject<ABaseItem>() : nullptr;
+		if (!Prototype)
+		{
+			continue;
+		}
+
+		// 게임과 같은 순서로 효과 결정: 클래스 기본값 → ItemEffectTable → 스폰 행
+		FItemEffectRow Effect;
+		Prototype->DescribeEffect(Effect);
+		if (EffectTable)
+		{
+			if (const FItemEffectRow* TableRow = EffectTable->FindRow<FItemEffectRow>(static_cast<const IItemInterface*>(Prototype)->GetItemType(), ContextString, false))
+			{
+				Effect = *TableRow;
+			}
+		}
+		if (Row->EffectMagnitude > 0.0f)
+		{
+			Effect.Magnitude = Row->EffectMagnitude;
+		}
+
+		const float Chance = Row->SpawnChance / TotalChance;
+		if (Effect.bCountsAsCoin)
+		{
+			OutMix.CoinChance += Chance;
+			CoinScoreSum += Chance * (Effect.EffectType == EItemEffectType::Score ? Effect.Magnitude : 0.0f);
+		}
+		else if (Effect.EffectType == EItemEffectType::RadialDamage)
+		{
+			OutMix.MineChance += Chance;
+			MineDamageSum += Chance * Effect.Magnitude;
+		}
+		else if (Effect.EffectType == EItemEffectType::Heal)
+		{
+			OutMix.HealChance += Chance;
+			HealAmountSum += Chance * Effect.Magnitude;
+		}
+	}
+
+	OutMix.AverageCoinScore = OutMix.CoinChance > 0.0f ? CoinScoreSum / OutMix.CoinChance : 0.0f;
+	OutMix.MineDamage = OutMix.MineChance > 0.0f ? MineDamageSum / OutMix.MineChance : 0.0f;
+	OutMix.HealAmount = OutMix.HealChance > 0.0f ? HealAmountSum / OutMix.HealChance : 0.0f;
+	return true;
+}
+
+int32 UWaveBalanceCommandlet::Main(const FString& Params)
+{
+	// 웨이브 설정: 게임 스테이트 기본값 → 명령줄
+	const UClass* StateClass = GameStateClass.IsNull() ? ABaseGameState::StaticClass() : GameStateClass.LoadSynchronous();
+	if (!StateClass)
+	{
+		UE_LOG(LogTemp, Error, TEXT("Failed to load GameStateClass %s"), *GameStateClass.ToString());
+		return 1;
+	}
+	FWaveRulesConfig Config = StateClass->GetDefaultObject<ABaseGameState>()->MakeRulesConfig();
+
+	TArray<float> ListValues;
+	ParseList(Params, TEXT("ItemsPerWave="), ListValues);
+	if (!ListValues.IsEmpty())
+	{
+		Config.ItemsPerWave.Reset();
+		for (const float Value : ListValues)
+		{
+			Config.ItemsPerWave.Add(FMath::RoundToInt(Value));
+		}
+	}
+	ListValues.Reset();
+	ParseList(Params, TEXT("WaveDurations="), ListValues);
+	if (!ListValues.IsEmpty())
+	{
+		Config.WaveDurations = ListValues;
+	}
+	FParse::Value(*Params, TEXT("MaxLevels="), Config.MaxLevels);
+	FParse::Value(*Params, TEXT("MaxWaves="), Config.MaxWaves);
+
+	FSimPlayerModel Player;
+	FParse::Value(*Params, TEXT("CoinSeconds="), Player.NearestCoinSeconds);
+	FParse::Value(*Params, TEXT("MineHitChance="), Player.MineHitChance);
+	FParse::Value(*Params, TEXT("HealChance="), Player.HealPickupChance);
+	FParse::Value(*Params, TEXT("MaxHealth="), Player.MaxHealth);
+
+	int32 NumRuns = DefaultRuns;
+	int32 Seed = 1;
+	FParse::Value(*Params, TEXT("Runs="), NumRuns);
+	FParse::Value(*Params, TEXT("Seed="), Seed);
+	NumRuns = FMath::Max(NumRuns, 1);
+
+	// 아이템 구성: 레벨별 스폰 DataTable
+	const UDataTable* EffectTable = GetDefault<UItemEffectSubsystem>()->GetItemEffectTable().LoadSynchronous();
+	TArray<FSimLevelItemMix> Levels;
+	for (const TSoftObjectPtr<UDataTable>& TablePtr : LevelItemTables)
+	{
+		const UDataTable* SpawnTable = TablePtr.LoadSynchronous();
+		FSimLevelItemMix Mix;
+		if (!SpawnTable || !BuildLevelItemMix(*SpawnTable, EffectTable, Mix))
+		{
+			UE_LOG(LogTemp, Error, TEXT("Spawn table %s is missing or has no spawnable rows"), *TablePtr.ToString());
+			return 1;
+		}
+		UE_LOG(LogTemp, Display, TEXT("Level %d (%s): coin %.2f (avg %.1f pts), mine %.2f (%.0f dmg), heal %.2f (+%.0f)"),
+			Levels.Num(), *SpawnTable->GetName(), Mix.CoinChance, Mix.AverageCoinScore, Mix.MineChance, Mix.MineDamage, Mix.HealChance, Mix.HealAmount);
+		Levels.Add(Mix);
+	}
+	if (Levels.IsEmpty())
+	{
+		UE_LOG(LogTemp, Error, TEXT("No LevelItemTables configured in [/Script/CH8_UI.WaveBalanceCommandlet]"));
+		return 1;
+	}
+
+	const double StartTime = FPlatformTime::Seconds();
+	TArray<FSimRunResult> Results;
+	WaveBalanceSimulation::SimulateRuns(Config, Levels, Player, NumRuns, Seed, Results);
+	const double ElapsedSeconds = FMath::Max(FPlatformTime::Seconds() - StartTime, UE_DOUBLE_SMALL_NUMBER);
+
+	// 레벨별 집계
+	TArray<FString> Lines;
+	Lines.Add(TEXT("Level,Reached,ReachRate,Cleared,ClearRate,Deaths,Wave1Fails,Wave2Fails,Wave3PlusFails,ScoreP10,ScoreP50,ScoreP90"));
+
+	for (int32 LevelIndex = 0; LevelIndex < Config.MaxLevels; LevelIndex++)
+	{
+		int32 Reached = 0;
+		int32 Cleared = 0;
+		int32 Deaths = 0;
+		int32 WaveFails[3] = { 0, 0, 0 };
+		TArray<int32> Scores;
+		Scores.Reserve(NumRuns);
+
+		for (const FSimRunResult& Result : Results)
+		{
+			if (Result.LevelsCleared < LevelIndex)
+			{
+				continue;
+			}
+			Reached++;
+			if (Result.LevelsCleared > LevelIndex)
+			{
+				Cleared++;
+			}
+			else if (Result.FailedLevel == LevelIndex)
+			{
+				WaveFails[FMath::Clamp(Result.FailedWave, 0, 2)]++;
+				Deaths += Result.bDied ? 1 : 0;
+			}
+			if (Result.ScoreAtLevelEnd.IsValidIndex(LevelIndex))
+			{
+				Scores.Add(Result.ScoreAtLevelEnd[LevelIndex]);
+			}
+		}
+
+		Scores.Sort();
+		Lines.Add(FString::Printf(TEXT("%d,%d,%.4f,%d,%.4f,%d,%d,%d,%d,%d,%d,%d"),
+			LevelIndex + 1,
+			Reached, static_cast<float>(Reached) / NumRuns,
+			Cleared, Reached > 0 ? static_cast<float>(Cleared) / Reached : 0.0f,
+			Deaths, WaveFails[0], WaveFails[1], WaveFails[2],
+			CH8Stats::SortedPercentile(Scores, 0.1f), CH8Stats::SortedPercentile(Scores, 0.5f), CH8Stats::SortedPercentile(Scores, 0.9f)));
+
+		UE_LOG(LogTemp, Display, TEXT("Level %d: reached %.1f%%, cleared %.1f%% of those, score P10/P50/P90 = %d/%d/%d"),
+			LevelIndex + 1, 100.0f * Reached / NumRuns, Reached > 0 ? 100.0f * Cleared / Reached : 0.0f,
+			CH8Stats::SortedPercentile(Scores, 0.1f), CH8Stats::SortedPercentile(Scores, 0.5f), CH8Stats::SortedPercentile(Scores, 0.9f));
+	}
+
+	FString OutPath;
+	if (!FParse::Value(*Params, TEXT("Out="), OutPath))
+	{
+		OutPath = FPaths::ProjectSavedDir() / TEXT("Balance") / FString::Printf(TEXT("WaveBalance-%s.csv"), *FDateTime::Now().ToString());
+	}
+	if (!FFileHelper::SaveStringArrayToFile(Lines, *OutPath))
+	{
+		UE_LOG(LogTemp, Error, TEXT("Failed to write %s"), *OutPath);
+		return 1;
+	}
+
+	UE_LOG(LogTemp, Display, TEXT("Simulated %d runs in %.2fs (%.0f runs/min) to %s"),
+		NumRuns, ElapsedSeconds, NumRuns * 60.0 / ElapsedSeconds, *OutPath);
+	return 0;
+}
@@ -0,0 +1,140 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "WaveBalanceSimulation.h"
+#include "Async/ParallelFor.h"
+
+namespace WaveBalanceSimulation
+{
+	FSimRunResult SimulateRun(
+		const FWaveRulesConfig& Config,
+		TConstArrayView<FSimLevelItemMix> Levels,
+		const FSimPlayerModel& Player,
+		FRandomStream& Random)
+	{
+		FSimRunResult Result;
+		FWaveRules Rules;
+		Rules.Configure(Config);
+		Rules.StartLevel(0);
+
+		float Health = Player.MaxHealth;
+
+		for (;;)
+		{
+			const FSimLevelItemMix& Mix = Levels.IsValidIndex(Rules.GetLevelIndex()) ? Levels[Rules.GetLevelIndex()] : Levels.Last();
+
+			// 스폰: SpawnVolume::GetRandomItem 과 같은 비율로 아이템 종류를 뽑음
+			const int32 NumItems = Rules.GetItemsForCurrentWave();
+			int32 NumCoins = 0;
+			int32 NumMines = 0;
+			int32 NumHeals = 0;
+			for (int32 ItemIndex = 0; ItemIndex < NumItems; ItemIndex++)
+			{
+				const float Roll = Random.GetFraction();
+				if (Roll < Mix.CoinChance)
+				{
+					NumCoins++;
+				}
+				else if (Roll < Mix.CoinChance + Mix.MineChance)
+				{
+					NumMines++;
+				}
+				else if (Roll < Mix.CoinChance + Mix.MineChance + Mix.HealChance)
+				{
+					NumHeals++;
+				}
+			}
+
+			Rules.StartWave(NumCoins);
+
+			// 플레이: 남은 코인이 적을수록 다음 코인까지 멀어짐
+			const float WaveDuration = Rules.GetCurrentWaveDuration();
+			float WaveTime = 0.0f;
+			EWaveRulesStep Step = EWaveRulesStep::None;
+			bool bFailed = NumCoins == 0;
+
+			for (int32 Remaining = NumCoins; Remaining > 0; Remaining--)
+			{
+				const float MeanSeconds = Player.NearestCoinSeconds / FMath::Sqrt(static_cast<float>(Remaining));
+				WaveTime += -FMath::Loge(FMath::Max(Random.GetFraction(), UE_SMALL_NUMBER)) * MeanSeconds;
+				if (WaveTime > WaveDuration)
+				{
+					bFailed = true;
+					break;
+				}
+
+				const float ItemCount = static_cast<float>(FMath::Max(NumItems, 1));
+				if (NumMines > 0 && Random.GetFraction() < Player.MineHitChance * NumMines / ItemCount)
+				{
+					NumMines--;
+					Health -= Mix.MineDamage;
+					if (Health <= 0.0f)
+					{
+						Result.bDied = true;
+						bFailed = true;
+						break;
+					}
+				}
+				if (NumHeals > 0 && Random.GetFraction() < Player.HealPickupChance * NumHeals / ItemCount)
+				{
+					NumHeals--;
+					Health = FMath::Min(Health + Mix.HealAmount, Player.MaxHealth);
+				}
+
+				Rules.AddScore(FMath::RoundToInt(Mix.AverageCoinScore));
+				Step = Rules.CollectCoins(1);
+			}
+
+			Result.PlayTimeSeconds += bFailed ? FMath::Min(WaveTime, WaveDuration) : WaveTime;
+
+			if (bFailed || Step != EWaveRulesStep::WaveCleared)
+			{
+				Rules.FailWave();
+				Result.FailedLevel = Rules.GetLevelIndex();
+				Result.FailedWave = Rules.GetWaveIndex();
+				Result.ScoreAtLevelEnd.Add(Rules.GetScore());
+				break;
+			}
+
+			if (Rules.AdvanceWave() == EWaveRulesStep::LevelCleared)
+			{
+				Result.LevelsCleared++;
+				Result.ScoreAtLevelEnd.Add(Rules.GetScore());
+
+				// 실제 게임과 같이 레벨을 넘어가도 체력은 유지되지 않고 새 캐릭터로 시작
+				Health = Player.MaxHealth;
+				if (Rules.AdvanceLevel() == EWaveRulesStep::GameCleared)
+				{
+					break;
+				}
+				const int32 NextLevelIndex = Rules.GetLevelIndex();
+				Rules.StartLevel(NextLevelIndex);
+			}
+		}
+
+		Result.TotalScore = Rules.GetScore();
+		return Result;
+	}
+
+	void SimulateRuns(
+		const FWaveRulesConfig& Config,
+		TConstArrayView<FSimLevelItemMix> Levels,
+		const FSimPlayerModel& Player,
+		int32 NumRuns,
+		int32 Seed,
+		TArray<FSimRunResult>& OutResults)
+	{
+		OutResults.SetNum(NumRuns);
+		if (Levels.IsEmpty())
+		{
+			return;
+		}
+
+		// 실행마다 독립된 난수열을 쓰므로 결과가 스레드 배치와 무관
+		ParallelFor(NumRuns, [&](int32 RunIndex)
+		{
+			FRandomStream Random(Seed + RunIndex);
+			OutResults[RunIndex] = SimulateRun(Config, Levels, Player, Random);
+		});
+	}
+}
@@ -0,0 +1,85 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "WaveRules.h"
+
+void FWaveRules::Configure(const FWaveRulesConfig& InConfig)
+{
+	Config = InConfig;
+}
+
+void FWaveRules::StartLevel(int32 InLevelIndex)
+{
+	LevelIndex = InLevelIndex;
+	WaveIndex = 0;
+	SpawnedCoins = 0;
+	CollectedCoins = 0;
+	bWaveActive = false;
+	bGameCleared = false;
+}
+
+void FWaveRules::StartWave(int32 InSpawnedCoins)
+{
+	SpawnedCoins = InSpawnedCoins;
+	CollectedCoins = 0;
+	bWaveActive = true;
+}
+
+EWaveRulesStep FWaveRules::CollectCoins(int32 Count)
+{
+	if (!bWaveActive)
+	{
+		return EWaveRulesStep::None;
+	}
+
+	CollectedCoins += Count;
+
+	// 코인이 하나도 스폰되지 않은 웨이브는 시간이 다 될 때까지 끝나지 않음
+	if (SpawnedCoins > 0 && CollectedCoins >= SpawnedCoins)
+	{
+		bWaveActive = false;
+		return EWaveRulesStep::WaveCleared;
+	}
+	return EWaveRulesStep::None;
+}
+
+EWaveRulesStep FWaveRules::AdvanceWave()
+{
+	WaveIndex++;
+	return WaveIndex < Config.MaxWaves ? EWaveRulesStep::NextWave : EWaveRulesStep::LevelCleared;
+}
+
+EWaveRulesStep FWaveRules::AdvanceLevel()
+{
+	LevelIndex++;
+	if (LevelIndex >= Config.MaxLevels)
+	{
+		bGameCleared = true;
+		return EWaveRulesStep::GameCleared;
+	}
+	return EWaveRulesStep::NextLevel;
+}
+
+EWaveRulesStep FWaveRules::FailWave()
+{
+	bWaveActive = false;
+	return EWaveRulesStep::GameOver;
+}
+
+EWaveRulesStep FWaveRules::ExpireCoins(int32 Count)
+{
+	if (!bWaveActive)
+	{
+		return EWaveRulesStep::None;
+	}
+
+	SpawnedCoins = FMath::Max(SpawnedCoins - Count, 0);
+
+	// 모든 코인이 사라진 경우도 클리어로 보지 않고 시간 초과를 기다림
+	if (SpawnedCoins > 0 && CollectedCoins >= SpawnedCoins)
+	{
+		bWaveActive = false;
+		return EWaveRulesStep::WaveCleared;
+	}
+	return EWaveRulesStep::None;
+}
@@ -0,0 +1,228 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "WaveSpawnPlannerSubsystem.h"
+#include "BaseGameInstance.h"
+#include "SpawnVolume.h"
+#include "ItemSpawnRow.h"
+#include "ItemEffectSubsystem.h"
+#include "Algo/BinarySearch.h"
+#include "Engine/DataTable.h"
+#include "Engine/World.h"
+#include "GameplayAllocCheck.h"
+#include "Tasks/Task.h"
+
+DEFINE_LOG_CATEGORY(LogWavePlanner);
+
+bool UWaveSpawnPlannerSubsystem::ShouldCreateSubsystem(UObject* Outer) const
+{
+	const UWorld* World = Cast<UWorld>(Outer);
+	return World && World->IsGameWorld();
+}
+
+void UWaveSpawnPlannerSubsystem::Deinitialize()
+{
+	// 태스크가 이 서브시스템의 뒤 버퍼에 쓰고 있으므로 끝날 때까지 기다림
+	WaitForTask();
+
+	Super::Deinitialize();
+}
+
+void UWaveSpawnPlannerSubsystem::WaitForTask()
+{
+	if (PlanTask.IsValid())
+	{
+		PlanTask.Wait();
+		PlanTask = UE::Tasks::FTask();
+	}
+}
+
+bool UWaveSpawnPlannerSubsystem::MakeInputs(ASpawnVolume* SpawnVolume, int32 LevelIndex, int32 WaveIndex, int32 ItemCount, FPlanInputs& OutInputs) const
+{
+	UDataTable* ItemDataTable = SpawnVolume ? SpawnVolume->GetItemDataTable() : nullptr;
+	UItemEffectSubsystem* EffectSubsystem = GetWorld()->GetSubsystem<UItemEffectSubsystem>();
+	if (!ItemDataTable || !EffectSubsystem)
+	{
+		return false;
+	}
+
+	OutInputs.LevelIndex = LevelIndex;
+	OutInputs.WaveIndex = WaveIndex;
+	OutInputs.ItemCount = ItemCount;
+	// 미리 계획이 늦어 게임 스레드에서 다시 만들어도 같은 시드가 나오도록 공유 난수에서 뽑지 않고 (RunSeed, 레벨, 웨이브) 로 정함
+	const UBaseGameInstance* GameInstance = GetWorld()->GetGameInstance<UBaseGameInstance>();
+	OutInputs.Seed = GameInstance
+		? static_cast<int32>(HashCombine(GetTypeHash(GameInstance->RunSeed), HashCombine(GetTypeHash(LevelIndex), GetTypeHash(WaveIndex))))
+		: FMath::Rand();
+
+	const UScriptStruct* RowStruct = ItemDataTable->GetRowStruct();
+	if (!RowStruct || !RowStruct->IsChildOf(FItemSpawnRow::StaticStruct()))
+	{
+		return false;
+	}
+
+	// GetAllRows 는 호출마다 배열을 새로 만들므로 행 맵을 직접 순회
+	OutInputs.Rows.Reset();
+	OutInputs.CumulativeChance.Reset();
+	OutInputs.CoinRows.Reset();
+	float TotalChance = 0.0f;
+	for (const TPair<FName, uint8*>& RowPair : ItemDataTable->GetRowMap())
+	{
+		const FItemSpawnRow* Row = reinterpret_cast<const FItemSpawnRow*>(RowPair.Value);
+		TotalChance += Row->SpawnChance;
+		OutInputs.Rows.Add(Row);
+		OutInputs.CumulativeChance.Add(TotalChance);
+		// 처음 보는 종류의 등록이 필요하므로 게임 스레드에서 판정
+		OutInputs.CoinRows.Add(EffectSubsystem->CountsAsCoin(Row->ItemClass));
+	}
+
+	OutInputs.ReachablePoints.Reset();
+	OutInputs.ReachablePoints.Append(SpawnVolume->GetReachablePoints());
+	SpawnVolume->GetSpawnBox(OutInputs.BoxOrigin, OutInputs.BoxExtent);
+	OutInputs.Region = SpawnVolume->GetSpawnRegion();
+	return true;
+}
+
+void UWaveSpawnPlannerSubsystem::BuildPlan(FPlanInputs& Inputs, FWaveSpawnPlan& OutPlan, double& OutMs)
+{
+	const double StartTime = FPlatformTime::Seconds();
+
+	OutPlan.LevelIndex = Inputs.LevelIndex;
+	OutPlan.WaveIndex = Inputs.WaveIndex;
+	OutPlan.Rows.Reset(Inputs.ItemCount);
+	OutPlan.Locations.Reset(Inputs.ItemCount);
+	OutPlan.CoinCount = 0;
+
+	if (Inputs.Rows.IsEmpty())
+	{
+		OutMs = 0.0;
+		return;
+	}
+
+	// FMath 의 전역 난수는 스레드 안전하지 않으므로 요청 시 받은 시드로 스트림 사용
+	FRandomStream Stream(Inputs.Seed);
+	const float TotalChance = Inputs.CumulativeChance.Last();
+	// 한 웨이브 안에서 같은 지점에 아이템이 겹치지 않도록 지점은 비복원 추출 (부분 Fisher-Yates)
+	// 아이템이 지점보다 많을 때만 한 바퀴를 다 쓴 뒤 다시 처음부터
+	const int32 NumPoints = Inputs.ReachablePoints.Num();
+	int32 NextPoint = 0;
+
+	for (int32 i = 0; i < Inputs.ItemCount; i++)
+	{
+		// ASpawnVolume::GetRandomItem 과 같은 선택: 누적 확률이 처음으로 난수 이상이 되는 행
+		const float RandValue = Stream.FRandRange(0.0f, TotalChance);
+		const int32 RowIndex = FMath::Min(Algo::LowerBound(Inputs.CumulativeChance, RandValue), Inputs.Rows.Num() - 1);
+
+		FVector Location;
+		if (NumPoints > 0)
+		{
+			if (NextPoint >= NumPoints)
+			{
+				NextPoint = 0;
+			}
+			Inputs.ReachablePoints.Swap(NextPoint, NextPoint + Stream.RandHelper(NumPoints - NextPoint));
+			Location = Inputs.ReachablePoints[NextPoint++];
+		}
+		else if (Inputs.Region)
+		{
+			Location = Inputs.Region->GetRandomPoint(Stream);
+		}
+		else
+		{
+			Location = Inputs.BoxOrigin + FVector(
+				Stream.FRandRange(-Inputs.BoxExtent.X, Inputs.BoxExtent.X),
+				Stream.FRandRange(-Inputs.BoxExtent.Y, Inputs.BoxExtent.Y),
+				Stream.FRandRange(-Inputs.BoxExtent.Z, Inputs.BoxExtent.Z));
+		}
+
+		OutPlan.Rows.Add(Inputs.Rows[RowIndex]);
+		OutPlan.Locations.Add(Location);
+		if (Inputs.CoinRows[RowIndex])
+		{
+			OutPlan.CoinCount++;
+		}
+	}
+
+	OutMs = (FPlatformTime::Seconds() - StartTime) * 1000.0;
+}
+
+void UWaveSpawnPlannerSubsystem::RequestPlan(ASpawnVolume* SpawnVolume, int32 LevelIndex, int32 WaveIndex, int32 ItemCount)
+{
+	// 지난 요청이 아직 사용되지 않은 채 돌고 있으면 그 결과는 버림
+	WaitForTask();
+
+	const int32 BackIndex = 1 - FrontIndex;
+	if (!MakeInputs(SpawnVolume, LevelIndex, WaveIndex, ItemCount, PlanInputs[BackIndex]))
+	{
+		return;
+	}
+
+	PlannedVolume = SpawnVolume;
+	PlannedItemCount = ItemCount;
+
+	FPlanInputs* BackInputs = &PlanInputs[BackIndex];
+	FWaveSpawnPlan* BackPlan = &Plans[BackIndex];
+	double* BackMs = &BackPlanMs;
+
+	// 태스크 객체 생성은 엔진 몫이라 할당 검사에서 제외
+	CH8_ALLOC_ALLOW();
+	PlanTask = UE::Tasks::Launch(UE_SOURCE_LOCATION, [BackInputs, BackPlan, BackMs]()
+	{
+		BuildPlan(*BackInputs, *BackPlan, *BackMs);
+	});
+}
+
+const FWaveSpawnPlan& UWaveSpawnPlannerSubsystem::AcquirePlan(ASpawnVolume* SpawnVolume, int32 LevelIndex, int32 WaveIndex, int32 ItemCount)
+{
+	const TCHAR* FallbackReason = nullptr;
+
+	if (!PlanTask.IsValid())
+	{
+		NumUnplanned++;
+	}
+	else if (!PlanTask.IsCompleted())
+	{
+		// 기다리면 워커 계산 시간이 그대로 히치가 되므로 기다리지 않고 지금 계산 (늦은 결과는 다음 요청 때 버려짐)
+		FallbackReason = TEXT("not ready");
+	}
+	else
+	{
+		PlanTask = UE::Tasks::FTask();
+
+		const FWaveSpawnPlan& BackPlan = Plans[1 - FrontIndex];
+		if (PlannedVolume.Get() == SpawnVolume && PlannedItemCount == ItemCount
+			&& BackPlan.LevelIndex == LevelIndex && BackPlan.WaveIndex == WaveIndex)
+		{
+			FrontIndex = 1 - FrontIndex;
+			LastPlanMs = BackPlanMs;
+			NumPrecomputed++;
+			return Plans[FrontIndex];
+		}
+		FallbackReason = TEXT("stale");
+	}
+
+	if (FallbackReason)
+	{
+		NumFallbacks++;
+		UE_LOG(LogWavePlanner, Log, TEXT("Spawn plan for level %d wave %d %s, computing on game thread (%d fallbacks)"),
+			LevelIndex + 1, WaveIndex + 1, FallbackReason, NumFallbacks);
+	}
+
+	// 앞 버퍼는 게임 스레드 소유이므로 태스크가 돌고 있어도 바로 써도 됨
+	FWaveSpawnPlan& FrontPlan = Plans[FrontIndex];
+	FPlanInputs& FrontInputs = PlanInputs[FrontIndex];
+	if (MakeInputs(SpawnVolume, LevelIndex, WaveIndex, ItemCount, FrontInputs))
+	{
+		BuildPlan(FrontInputs, FrontPlan, LastPlanMs);
+	}
+	else
+	{
+		FrontPlan.LevelIndex = LevelIndex;
+		FrontPlan.WaveIndex = WaveIndex;
+		FrontPlan.Rows.Reset();
+		FrontPlan.Locations.Reset();
+		FrontPlan.CoinCount = 0;
+		LastPlanMs = 0.0;
+	}
+	return FrontPlan;
+}
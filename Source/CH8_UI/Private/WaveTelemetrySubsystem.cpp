@@ -0,0 +1,149 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "WaveTelemetrySubsystem.h"
+#include "BaseItem.h"
+#include "GameplayLLMTags.h"
+#include "EngineUtils.h"
+#include "HAL/FileManager.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "UObject/UObjectArray.h"
+
+DEFINE_LOG_CATEGORY(LogWaveTelemetry);
+
+bool UWaveTelemetrySubsystem::ShouldCreateSubsystem(UObject* Outer) const
+{
+	// 에디터 프리뷰 월드 등에서는 만들지 않음
+	const UWorld* World = Cast<UWorld>(Outer);
+	return World && World->IsGameWorld();
+}
+
+void UWaveTelemetrySubsystem::BeginWave(int32 LevelIndex, int32 WaveIndex)
+{
+	LLM_SCOPE_BYTAG(CH8Spawn);
+
+	ActiveLevelIndex = LevelIndex;
+	ActiveWaveIndex = WaveIndex;
+	CaptureSnapshot(StartSnapshot);
+	bWaveActive = true;
+}
+
+void UWaveTelemetrySubsystem::EndWave(const TCHAR* Outcome)
+{
+	if (!bWaveActive)
+	{
+		return;
+	}
+	bWaveActive = false;
+
+	LLM_SCOPE_BYTAG(CH8Spawn);
+
+	FWaveTelemetrySnapshot EndSnapshot;
+	CaptureSnapshot(EndSnapshot);
+	WriteRow(Outcome, EndSnapshot);
+}
+
+FString UWaveTelemetrySubsystem::GetReportFilePath()
+{
+	return FPaths::ProjectSavedDir() / TEXT("Telemetry") / TEXT("WaveTelemetry.csv");
+}
+
+void UWaveTelemetrySubsystem::CaptureSnapshot(FWaveTelemetrySnapshot& OutSnapshot) const
+{
+	OutSnapshot.Time = FPlatformTime::Seconds();
+	OutSnapshot.UObjectCount = GUObjectArray.GetObjectArrayNumMinusAvailable();
+	OutSnapshot.ComponentCount = 0;
+	OutSnapshot.LiveItemCount = 0;
+	OutSnapshot.ItemCounts.Reset();
+
+	for (TActorIterator<ABaseItem> It(GetWorld()); It; ++It)
+	{
+		const ABaseItem* Item = *It;
+		if (!IsValid(Item))
+		{
+			continue;
+		}
+
+		const IItemInterface* ItemInterface = Item;
+		OutSnapshot.ItemCounts.FindOrAdd(ItemInterface->GetItemType())++;
+		OutSnapshot.ComponentCount += Item->GetComponents().Num();
+		OutSnapshot.LiveItemCount++;
+	}
+
+	OutSnapshot.LLMTagAmounts.Reset();
+	for (const TCHAR* TagName : CH8LLM::TagNames)
+	{
+		OutSnapshot.LLMTagAmounts.Add(CH8LLM::GetTagAmount(TagName));
+	}
+}
+
+void UWaveTelemetrySubsystem::WriteRow(const TCHAR* Outcome, const FWaveTelemetrySnapshot& EndSnapshot) const
+{
+	const FString FilePath = GetReportFilePath();
+	const bool bWriteHeader = !IFileManager::Get().FileExists(*FilePath);
+
+	FString Row;
+	if (bWriteHeader)
+	{
+		Row += TEXT("Timestamp,Map,Level,Wave,Outcome,DurationSec,StartItems,EndItems,StartItemCounts,EndItemCounts,StartComponents,EndComponents,StartUObjects,EndUObjects,UObjectDelta");
+		for (const TCHAR* TagName : CH8LLM::TagNames)
+		{
+			Row += FString::Printf(TEXT(",%s_StartBytes,%s_EndBytes"), TagName, TagName);
+		}
+		Row += LINE_TERMINATOR;
+	}
+
+	// ItemType 별 개수는 한 칸에 "SmallCoin=20;Mine=5" 형식으로 기록
+	auto FormatItemCounts = [](const TMap<FName, int32>& Counts)
+	{
+		TArray<FName> Types;
+		Counts.GetKeys(Types);
+		Types.Sort(FNameLexicalLess());
+
+		FString Result;
+		for (const FName& Type : Types)
+		{
+			if (!Result.IsEmpty())
+			{
+				Result += TEXT(";");
+			}
+			Result += FString::Printf(TEXT("%s=%d"), *Type.ToString(), Counts[Type]);
+		}
+		return Result;
+	};
+
+	Row += FString::Printf(TEXT("%s,%s,%d,%d,%s,%.2f,%d,%d,%s,%s,%d,%d,%d,%d,%d"),
+		*FDateTime::Now().ToString(),
+		*GetWorld()->GetMapName(),
+		ActiveLevelIndex + 1,
+		ActiveWaveIndex + 1,
+		Outcome,
+		EndSnapshot.Time - StartSnapshot.Time,
+		StartSnapshot.LiveItemCount,
+		EndSnapshot.LiveItemCount,
+		*FormatItemCounts(StartSnapshot.ItemCounts),
+		*FormatItemCounts(EndSnapshot.ItemCounts),
+		StartSnapshot.ComponentCount,
+		EndSnapshot.ComponentCount,
+		StartSnapshot.UObjectCount,
+		EndSnapshot.UObjectCount,
+		EndSnapshot.UObjectCount - StartSnapshot.UObjectCount);
+
+	for (int32 TagIndex = 0; TagIndex < UE_ARRAY_COUNT(CH8LLM::TagNames); TagIndex++)
+	{
+		Row += FString::Printf(TEXT(",%lld,%lld"), StartSnapshot.LLMTagAmounts[TagIndex], EndSnapshot.LLMTagAmounts[TagIndex]);
+	}
+	Row += LINE_TERMINATOR;
+
+	if (!FFileHelper::SaveStringToFile(Row, *FilePath, FFileHelper::EEncodingOptions::ForceUTF8WithoutBOM, &IFileManager::Get(), FILEWRITE_Append))
+	{
+		UE_LOG(LogWaveTelemetry, Warning, TEXT("Failed to write wave telemetry to %s"), *FilePath);
+		return;
+	}
+
+	UE_LOG(LogWaveTelemetry, Log, TEXT("Level %d Wave %d %s: items %d -> %d, UObjects %+d"),
+		ActiveLevelIndex + 1, ActiveWaveIndex + 1, Outcome,
+		StartSnapshot.LiveItemCount, EndSnapshot.LiveItemCount,
+		EndSnapshot.UObjectCount - StartSnapshot.UObjectCount);
+}
@@ -16,6 +16,9 @@ class CH8_UI_API UBaseGameInstance : public UGameInstance
 	
 public:
 	UBaseGameInstance();
+
+	virtual void Init() override;
+	virtual void Shutdown() override;
 	
 	// 게임 전체 누적 점수
 	UPROPERTY(VisibleAnywhere, BlueprintReadWrite, Category = "GameData")
@@ -24,6 +27,16 @@ public:
 	UPROPERTY(VisibleAnywhere, BlueprintReadWrite, Category = "GameData")
 	int32 CurrentLevelIndex;
 	
+	// 리더보드에 남길 이번 판 정보 (BeginRun 에서 초기화)
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "GameData")
+	int32 RunSeed;
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "GameData")
+	TArray<int32> LevelScores;
+	double RunStartTime;
+	bool bRunRecorded;
+	
 	UFUNCTION(BlueprintCallable, Category = "GameData")
 	void AddToScore(int32 Amount);
+	// 새 판 시작: 점수와 레벨을 초기화하고 난수 시드를 정함
+	void BeginRun();
 };
\ No newline at end of file
@@ -2,6 +2,8 @@
 
 #include "CoreMinimal.h"
 #include "GameFramework/GameState.h"
+#include "WaveRules.h"
+#include "GameplaySchedulerSubsystem.h"
 #include "BaseGameState.generated.h"
 
 UCLASS()
@@ -36,9 +38,10 @@ public:
 	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Wave")
 	TArray<int32> ItemsPerWave;
 
-	FTimerHandle WaveTimerHandle;
-	FTimerHandle HUDUpdateTimerHandle;
-	FTimerHandle WaveTextTimerHandle;
+	// UGameplaySchedulerSubsystem 에 예약된 웨이브 제한 시간, HUD 갱신 주기, 웨이브 문구 숨기기
+	FGameplayTimerHandle WaveTimerHandle;
+	FGameplayTimerHandle HUDUpdateTimerHandle;
+	FGameplayTimerHandle WaveTextTimerHandle;
 
 	UFUNCTION(BlueprintPure, Category = "Score")
 	int32 GetScore() const;
@@ -46,6 +49,8 @@ public:
 	void AddScore(int32 Amount);
 	UFUNCTION(BlueprintCallable, Category = "Level")
 	void OnGameOver();
+	bool IsGameOver() const { return bGameOver; }
+	bool IsWaveActive() const { return Rules.IsWaveActive(); }
 
 	void StartLevel();
 	void StartWave();
@@ -53,6 +58,47 @@ public:
 	void ClearAllItems();
 	void NextLevel();
 	void OnCoinCollected();
+	// 한 프레임에 여러 코인이 모였을 때 완료 판정을 한 번만 하도록 묶어서 처리
+	void OnCoinsCollected(int32 Count);
+	// 수명이 다해 사라진 코인. 웨이브 완료에 필요한 코인 수에서 뺀다
+	void OnCoinsExpired(int32 Count);
+	void OnWaveCleared();
 	void UpdateHUD();
 	void HideWaveText();
+
+	// 에디터에서 설정한 Level/Wave 프로퍼티로 규칙 설정 생성 (밸런스 시뮬레이터는 CDO 에서 호출)
+	FWaveRulesConfig MakeRulesConfig() const;
+
+#if !UE_BUILD_SHIPPING
+	// 콘솔 명령용 (ch8.SkipToWave, ch8.SkipToLevel). 인덱스는 0부터
+	void DebugSkipToWave(int32 WaveIndex);
+	void DebugSkipToLevel(int32 LevelIndex);
+#endif
+
+protected:
+	// 웨이브 시작/종료를 텔레메트리, 소크 테스트 등 관찰자에게 알림
+	void NotifyWaveStarted();
+	void NotifyWaveEnded(const TCHAR* Outcome);
+
+	// 웨이브 아이템 수 (개발 빌드에서는 ch8.ItemsPerWave 가 우선)
+	int32 GetItemsToSpawn(int32 WaveIndex) const;
+
+	void ScheduleTimer(FGameplayTimerHandle& Handle, float Delay, EGameplayTimerKind Kind);
+	void CancelTimer(FGameplayTimerHandle& Handle);
+	void RegisterTimerHandlers();
+
+	bool bWaveInProgress = false;
+	// 게임 오버 처리가 끝났는지 (사망과 시간 초과가 겹치거나 사망 후 데미지가 이어져도 한 번만 처리)
+	bool bGameOver = false;
+
+	// HUD 문구 캐시. 매 갱신마다 문자열을 만들지 않도록 값이 바뀔 때만 교체
+	void BuildHUDTexts();
+	TArray<FText> TimeTexts;
+	FText LevelText;
+	int32 ShownTimeTenths = INDEX_NONE;
+	int32 ShownScore = INDEX_NONE;
+
+	// 웨이브/레벨 규칙 (위의 Level/Wave/Coin 프로퍼티는 이 값을 비춰주는 복사본)
+	FWaveRules Rules;
+	void SyncFromRules();
 };
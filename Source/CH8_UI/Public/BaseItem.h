@@ -4,10 +4,13 @@
 
 #include "CoreMinimal.h"
 #include "ItemInterface.h"
+#include "ItemEffectTypes.h"
+#include "GameplayTimingWheel.h"
 #include "GameFramework/Actor.h"
 #include "BaseItem.generated.h"
 
 class USphereComponent;
+struct FItemSpawnRow;
 
 UCLASS()
 class CH8_UI_API ABaseItem : public AActor, public IItemInterface
@@ -16,6 +19,24 @@ class CH8_UI_API ABaseItem : public AActor, public IItemInterface
 	
 public:    
 	ABaseItem();
+
+	// SpawnVolume 이 스폰 직후 DataTable 행의 효과 설정을 넘겨줌
+	virtual void ApplySpawnRow(const FItemSpawnRow& SpawnRow);
+	// 효과 테이블에 행이 없을 때 사용할 이 클래스의 기본 효과
+	virtual void DescribeEffect(FItemEffectRow& OutEffect) const;
+
+	FItemTypeId GetItemTypeId() const { return ItemTypeId; }
+	bool IsEffectPending() const { return bEffectPending; }
+	const FItemEffectOverrides& GetEffectOverrides() const { return EffectOverrides; }
+
+	// USpawnRecordSubsystem 의 기록에서 만들어진 아이템이면 그 기록
+	void SetSpawnRecord(int32 RecordIndex, uint32 RecordSerial) { SpawnRecordIndex = RecordIndex; SpawnRecordSerial = RecordSerial; }
+	// 수명 만료까지 남은 시간 (수명이 없으면 0)
+	float GetRemainingLifetime() const;
+	void SetRemainingLifetime(float Lifetime);
+
+	// 아이템을 제거하는 공통 함수 (추가 이펙트나 로직을 넣을 수 있음)
+	virtual void DestroyItem();
     
 protected:
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Item")
@@ -30,6 +51,22 @@ protected:
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Item|Component")
 	UStaticMeshComponent* StaticMesh;
 
+	// ItemType 에 대해 UItemEffectSubsystem 이 발급한 ID
+	FItemTypeId ItemTypeId = InvalidItemTypeId;
+	// 스폰 행이 이 아이템에만 덮어쓴 효과 값
+	FItemEffectOverrides EffectOverrides;
+	// 지연 효과가 적용되기를 기다리는 중 (중복 발동 방지)
+	bool bEffectPending = false;
+	// 스케줄러에 예약된 지연 효과와 수명 만료. 아이템이 먼저 사라지면 EndPlay 에서 취소
+	FGameplayTimerHandle EffectTimerHandle;
+	FGameplayTimerHandle ExpiryTimerHandle;
+
+	int32 SpawnRecordIndex = INDEX_NONE;
+	uint32 SpawnRecordSerial = 0;
+
+	virtual void BeginPlay() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
 	virtual void OnItemOverlap(
 			UPrimitiveComponent* OverlappedComp,
 			AActor* OtherActor,
@@ -44,7 +81,4 @@ protected:
 			int32 OtherBodyIndex) override;
 	virtual void ActivateItem(AActor* Activator) override;
 	virtual FName GetItemType() const override;
-		
-	// 아이템을 제거하는 공통 함수 (추가 이펙트나 로직을 넣을 수 있음)
-	virtual void DestroyItem();
 };
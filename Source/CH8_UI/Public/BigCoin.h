@@ -16,6 +16,4 @@ class CH8_UI_API ABigCoin : public ACoinItem
 
 public:
 	ABigCoin();
-	
-	virtual void ActivateItem(AActor* Activator) override;
 };
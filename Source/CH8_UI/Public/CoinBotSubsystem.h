@@ -0,0 +1,45 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "CoinBotSubsystem.generated.h"
+
+/**
+ * 스크립트 봇. -CoinBot 또는 -SoakRuns=N 으로 실행하면 0번 플레이어 캐릭터를 대신 조종한다.
+ * 가장 가까운 코인으로 이동하며, 지뢰 근처 코인은 뒤로 미루고 이동 중에는 지뢰를 피해 돌아간다.
+ * 캐릭터의 입력만 대신하므로 "Player" 태그, HUD, GameState 로직은 사람이 플레이할 때와 동일하게 동작한다.
+ */
+UCLASS()
+class CH8_UI_API UCoinBotSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual bool ShouldCreateSubsystem(UObject* Outer) const override;
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+
+protected:
+	void SelectTarget(const FVector& BotLocation);
+	bool IsNearMine(const FVector& Location, float Radius) const;
+
+	// 목표 재선정 주기
+	float RetargetInterval = 0.25f;
+	// 지뢰 폭발 범위(300)보다 약간 넓게 회피
+	float MineAvoidRadius = 350.0f;
+	// 지뢰 근처 코인에 붙는 거리 페널티
+	float MinePenaltyDistance = 2000.0f;
+	// 이 시간 동안 목표에 가까워지지 못하면 잠시 포기
+	float StuckTimeout = 3.0f;
+	float GiveUpDuration = 10.0f;
+
+	TWeakObjectPtr<AActor> TargetCoin;
+	double NextRetargetTime = 0.0;
+	double LastProgressTime = 0.0;
+	float BestTargetDistance = TNumericLimits<float>::Max();
+
+	TArray<FVector> MineLocations;
+	TMap<TWeakObjectPtr<AActor>, double> IgnoredCoinsUntil;
+};
@@ -17,11 +17,14 @@ class CH8_UI_API ACoinItem : public ABaseItem
 public:
 	ACoinItem();
 
+	virtual void DescribeEffect(FItemEffectRow& OutEffect) const override;
+
 protected:
 	// 코인 획득 시 플레이어에게 줄 점수
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Item")
 	int32 PointValue;
 
-	// 부모 클래스에서 상속받은 ActivateItem 함수를 오버라이드
-	virtual void ActivateItem(AActor* Activator) override;
+	// 코인 공간 색인 등록/해제
+	virtual void BeginPlay() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
 };
\ No newline at end of file
@@ -0,0 +1,67 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "CoinSpatialIndexSubsystem.generated.h"
+
+class ACoinItem;
+
+/**
+ * 살아있는 코인을 XY 균일 격자에 등록해두고 반경 질의를 제공한다.
+ * 코인은 BeginPlay/EndPlay 에서 스스로 등록/해제한다.
+ * 자석 효과(StartAttraction)도 여기서 처리하며, 끌려오는 모든 코인의 이동을 프레임당 한 번의 일괄 계산으로 갱신한다.
+ */
+UCLASS()
+class CH8_UI_API UCoinSpatialIndexSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual bool ShouldCreateSubsystem(UObject* Outer) const override;
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+
+	void RegisterCoin(ACoinItem* Coin);
+	void UnregisterCoin(ACoinItem* Coin);
+	void UpdateCoinLocation(ACoinItem* Coin, const FVector& NewLocation);
+
+	// Center 로부터 Radius 안의 코인을 OutCoins 에 추가
+	void QueryCoinsInRadius(const FVector& Center, float Radius, TArray<ACoinItem*>& OutCoins) const;
+	int32 GetNumCoins() const { return CoinCells.Num(); }
+
+	// Target 주변 Radius 안의 코인을 Duration 동안 PullSpeed(cm/s)로 끌어당김
+	void StartAttraction(AActor* Target, float Radius, float Duration, float PullSpeed);
+
+protected:
+	FIntPoint GetCellCoord(const FVector& Location) const;
+	void UpdateAttraction(float DeltaTime);
+
+	// 격자 한 칸의 크기 (cm)
+	float CellSize = 500.0f;
+	// 이 거리 안으로 들어오면 도착으로 보고 획득 처리
+	float ArriveDistance = 50.0f;
+
+	TMap<FIntPoint, TArray<ACoinItem*, TInlineAllocator<8>>> Cells;
+	TMap<ACoinItem*, FIntPoint> CoinCells;
+
+	struct FMagnetAttractor
+	{
+		TWeakObjectPtr<AActor> Target;
+		double EndTime = 0.0;
+		float Radius = 0.0f;
+		float PullSpeed = 0.0f;
+	};
+	TArray<FMagnetAttractor> Attractors;
+
+	// 프레임마다 재사용하는 일괄 처리 버퍼 (SoA)
+	TArray<ACoinItem*> AttractedCoins;
+	TArray<AActor*> AttractedTargets;
+	TArray<float> PosX, PosY, PosZ;
+	TArray<float> GoalX, GoalY, GoalZ;
+	TArray<float> MaxStep;
+	TArray<bool> Arrived;
+	TSet<ACoinItem*> AttractedSet;
+	TArray<ACoinItem*> QueryResult;
+};
@@ -0,0 +1,110 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "Fonts/SlateFontInfo.h"
+#include "FloatingTextSubsystem.generated.h"
+
+class SFloatingTextLayer;
+
+enum class EFloatingTextKind : uint8
+{
+	Score,
+	Damage,
+};
+
+// 한 프레임에 그릴 팝업 하나. Tick 에서 계산하고 SFloatingTextLayer 가 그대로 그린다
+struct FFloatingTextDrawItem
+{
+	// 뷰포트 픽셀 좌표 (텍스트 중심)
+	FVector2f ScreenPosition = FVector2f::ZeroVector;
+	FVector2f HalfSize = FVector2f::ZeroVector;
+	FLinearColor Color = FLinearColor::White;
+	const FText* Text = nullptr;
+};
+
+/**
+ * "+10" 같은 점수 팝업과 데미지 숫자를 고정 크기 풀에서 재사용하며 띄운다.
+ * 위젯을 팝업마다 만들지 않고, 뷰포트에 붙인 SLeafWidget 하나가 모든 팝업을 한 번에 그린다.
+ * 투영과 페이드는 Tick 에서 한 번에 계산하고, 같은 값의 텍스트(FText)는 캐시에서 재사용한다.
+ * 풀이 가득 차면 가장 오래된 팝업을 덮어쓴다. 통계: stat CH8UI
+ */
+UCLASS(config=Game)
+class CH8_UI_API UFloatingTextSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual bool ShouldCreateSubsystem(UObject* Outer) const override;
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void Deinitialize() override;
+	virtual void OnWorldBeginPlay(UWorld& InWorld) override;
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+
+	void AddText(EFloatingTextKind Kind, int32 Value, const FVector& WorldLocation);
+
+	int32 GetPoolSize() const { return Entries.Num(); }
+	int32 GetNumActive() const { return NumActive; }
+	// 풀이 가득 차서 아직 살아있는 팝업을 덮어쓴 횟수
+	int32 GetNumOverwritten() const { return NumOverwritten; }
+
+	const TArray<FFloatingTextDrawItem>& GetDrawItems() const { return DrawItems; }
+	const FSlateFontInfo& GetFont() const { return Font; }
+
+protected:
+	struct FCachedText
+	{
+		FText Text;
+		FVector2f HalfSize = FVector2f::ZeroVector;
+		// 이 텍스트를 가리키는 살아있는 팝업 수. 0 이 아니면 내보내지 않음
+		int32 NumRefs = 0;
+		// 마지막으로 쓰이거나 그려진 프레임 (GFrameCounter). 이번 프레임 것은 DrawItems 가 가리킬 수 있어 내보내지 않음
+		uint64 LastUsedFrame = 0;
+	};
+
+	// 풀의 한 칸. 모든 팝업의 수명이 같으므로 생성 순서대로 원형 버퍼에 넣고 앞에서부터 만료시킨다
+	struct FFloatingTextEntry
+	{
+		FVector WorldLocation = FVector::ZeroVector;
+		float SpawnTime = 0.0f;
+		EFloatingTextKind Kind = EFloatingTextKind::Score;
+		FCachedText* Text = nullptr;
+	};
+
+	FCachedText& FindOrAddText(EFloatingTextKind Kind, int32 Value);
+	// 팝업이 가리키지 않는 항목을 오래 안 쓰인 순서로 내보냄
+	void EvictTexts();
+
+	UPROPERTY(Config)
+	int32 PoolSize = 64;
+	UPROPERTY(Config)
+	float Lifetime = 1.0f;
+	// 떠오르는 속도 (cm/s)
+	UPROPERTY(Config)
+	float RiseSpeed = 100.0f;
+	// 페이드 아웃이 시작되는 수명 비율
+	UPROPERTY(Config)
+	float FadeStart = 0.5f;
+	UPROPERTY(Config)
+	int32 FontSize = 24;
+	// 캐시할 텍스트 수 상한. 넘으면 오래 안 쓰인 항목부터 3/4 까지 내보냄 (살아있는 팝업이 가리키는 항목은 남김)
+	UPROPERTY(Config)
+	int32 MaxCachedTexts = 256;
+
+	TArray<FFloatingTextEntry> Entries;
+	int32 FirstActive = 0;
+	int32 NumActive = 0;
+	int32 NumOverwritten = 0;
+
+	// 값마다 TUniquePtr 로 보관해서 캐시가 커져도 Entries 가 가진 포인터가 유지됨
+	TMap<uint64, TUniquePtr<FCachedText>> TextCache;
+	// EvictTexts 에서 재사용 (마지막 사용 프레임, 키)
+	TArray<TPair<uint64, uint64>> EvictionCandidates;
+	TArray<FFloatingTextDrawItem> DrawItems;
+	FSlateFontInfo Font;
+
+	TSharedPtr<SFloatingTextLayer> Layer;
+};
@@ -0,0 +1,60 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+#if !UE_BUILD_SHIPPING
+
+/**
+ * 웨이브 한 사이클(스폰, 획득, HUD 갱신, 폭발)의 힙 할당 검사 (개발 빌드 전용).
+ * ch8.AllocCheck 1 또는 -CH8AllocCheck 로 켜면 GMalloc 앞에 세기용 프록시를 끼우고,
+ * CH8_ALLOC_SCOPE 구간 안에서 게임 스레드가 한 할당을 구간별로 센다. 액터 생성/제거처럼 허용된 할당은 CH8_ALLOC_ALLOW 로 뺀다.
+ * 레벨의 첫 웨이브는 풀과 캐시가 채워지는 준비 단계로 보고, 이후 웨이브가 끝날 때 할당이 하나라도 있었으면 실패로 보고한다.
+ * -CH8AllocCheck 로 실행했으면 첫 측정 웨이브가 끝난 뒤 결과를 종료 코드로 돌려주고 종료한다.
+ */
+namespace CH8AllocCheck
+{
+	enum class EScope : uint8
+	{
+		Spawn,
+		Pickup,
+		HUD,
+		Detonation,
+		Num
+	};
+
+	CH8_UI_API bool IsEnabled();
+
+	// 이 구간 안의 게임 스레드 할당을 Scope 로 셈 (중첩되면 안쪽 구간으로)
+	struct CH8_UI_API FScope
+	{
+		explicit FScope(EScope Scope);
+		~FScope();
+
+	private:
+		int32 PreviousScope;
+	};
+
+	// 이 구간 안의 할당은 세지 않음 (액터 생성/제거, 엔진 태스크 생성 등)
+	struct CH8_UI_API FAllowScope
+	{
+		FAllowScope();
+		~FAllowScope();
+	};
+
+	// ABaseGameState 가 레벨을 시작할 때 호출. -CH8AllocCheck 로 실행했으면 여기서 켬
+	CH8_UI_API void OnLevelStarted();
+	// ABaseGameState 가 웨이브가 끝날 때 호출. WaveIndex 0 은 준비 단계
+	CH8_UI_API void OnWaveEnded(int32 WaveIndex);
+}
+
+#define CH8_ALLOC_SCOPE(Scope) CH8AllocCheck::FScope PREPROCESSOR_JOIN(AllocCheckScope, __LINE__)(CH8AllocCheck::EScope::Scope)
+#define CH8_ALLOC_ALLOW() CH8AllocCheck::FAllowScope PREPROCESSOR_JOIN(AllocCheckAllow, __LINE__)
+
+#else
+
+#define CH8_ALLOC_SCOPE(Scope)
+#define CH8_ALLOC_ALLOW()
+
+#endif
@@ -0,0 +1,24 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+#if !UE_BUILD_SHIPPING
+
+/**
+ * 개발 빌드 전용 콘솔 명령(ch8.*)과 화면 오버레이(ch8.ShowOverlay 1).
+ * 게임 코드는 아래 함수로 측정값을 넘기고 오버라이드 값을 읽는다. 쉬핑 빌드에서는 호출부까지 모두 빠진다.
+ */
+namespace CH8Debug
+{
+	// 0 이하이면 오버라이드 없음
+	CH8_UI_API int32 GetItemsPerWaveOverride();
+	CH8_UI_API float GetWaveDurationOverride();
+
+	CH8_UI_API void RecordWaveSpawnTime(double Milliseconds, int32 ItemCount);
+	CH8_UI_API void RecordHUDUpdateTime(double Milliseconds);
+	CH8_UI_API void RecordOverlap();
+}
+
+#endif
@@ -0,0 +1,22 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "GameplayEventDecodeCommandlet.generated.h"
+
+/**
+ * 게임플레이 이벤트 로그(.ch8ev)를 CSV 로 변환한다.
+ * 사용법: UnrealEditor-Cmd CH8_UI.uproject -run=GameplayEventDecode -In=<파일> [-Out=<파일.csv>]
+ */
+UCLASS()
+class CH8_UI_API UGameplayEventDecodeCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+	UGameplayEventDecodeCommandlet();
+
+	virtual int32 Main(const FString& Params) override;
+};
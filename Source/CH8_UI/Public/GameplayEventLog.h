@@ -0,0 +1,124 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/Runnable.h"
+#include "Containers/Queue.h"
+#include <atomic>
+
+class FRunnableThread;
+class IFileHandle;
+
+// 게임플레이 이벤트 종류 (파일 포맷에 기록되므로 순서를 바꾸지 말 것)
+enum class EGameplayEventType : uint8
+{
+	None,
+	Pickup,			// Name: ItemType, A: 점수/회복량
+	Damage,			// A: 데미지, B: 남은 체력
+	Heal,			// A: 회복량, B: 회복 후 체력
+	Score,			// A: 획득 점수, B: 누적 점수
+	WaveStart,		// A: 레벨 인덱스, B: 웨이브 인덱스, Value: 스폰한 코인 수
+	WaveEnd,		// Name: 결과, A: 레벨 인덱스, B: 웨이브 인덱스
+	LevelChange,	// Name: 맵 이름, A: 레벨 인덱스
+	Death,			// A: 레벨 인덱스, B: 웨이브 인덱스
+	Explode,		// A: 데미지, B: 범위 안 플레이어 수
+	Dropped,		// 기록 스레드가 남김. A: 지금까지 버려진 이벤트 수
+	Spawn,			// Name: 스폰 행 이름
+};
+
+// 링 버퍼와 파일에 그대로 들어가는 고정 크기 레코드
+struct FGameplayEventRecord
+{
+	double Time = 0.0;		// 로그 시작 후 경과 시간(초)
+	EGameplayEventType Type = EGameplayEventType::None;
+	uint8 Flags = 0;
+	uint16 NameId = 0;		// 0 = 이름 없음, 그 외에는 파일 안의 이름 블록 ID
+	int32 A = 0;
+	int32 B = 0;
+	float Value = 0.0f;
+};
+static_assert(sizeof(FGameplayEventRecord) == 24, "Gameplay event record layout is part of the file format");
+
+/**
+ * 게임플레이 이벤트 스트림.
+ * 게임 스레드(단일 생산자)가 Push 로 레코드를 락 없는 링 버퍼에 넣고, 백그라운드 스레드가 주기적으로 비워 파일에 쓴다.
+ * 링이 가득 차면 이벤트를 버리고 DroppedCount 를 올린다 (게임 스레드는 절대 대기하지 않음).
+ *
+ * 파일 포맷: 헤더(FFileHeader) 뒤에 블록(FBlockHeader + 내용)이 반복된다.
+ *  - Records 블록: FGameplayEventRecord * Count
+ *  - Name 블록: NameId 와 UTF-8 문자열 (해당 이름을 쓰는 레코드보다 항상 먼저 기록됨)
+ */
+class CH8_UI_API FGameplayEventLog : public FRunnable
+{
+public:
+	static constexpr uint32 FileMagic = 0x45384843; // "CH8E"
+	static constexpr uint32 FileVersion = 1;
+
+	enum class EBlockType : uint32
+	{
+		Records = 1,
+		Name = 2,
+	};
+
+	struct FFileHeader
+	{
+		uint32 Magic = FileMagic;
+		uint32 Version = FileVersion;
+		uint32 RecordSize = sizeof(FGameplayEventRecord);
+		uint32 Reserved = 0;
+		int64 StartUtcTicks = 0;
+	};
+
+	struct FBlockHeader
+	{
+		EBlockType Type = EBlockType::Records;
+		uint32 Count = 0;		// Records: 레코드 수, Name: 문자열 바이트 수
+		uint32 NameId = 0;		// Name 블록에서만 사용
+		uint32 Reserved = 0;
+	};
+
+	explicit FGameplayEventLog(const FString& InFilePath, uint32 CapacityPow2 = 16384);
+	virtual ~FGameplayEventLog() override;
+
+	// 게임 스레드 전용. 링이 가득 차면 false
+	bool Push(EGameplayEventType Type, int32 A = 0, int32 B = 0, float Value = 0.0f, FName Name = NAME_None);
+
+	uint64 GetDroppedCount() const { return DroppedCount.load(std::memory_order_relaxed); }
+	uint64 GetWrittenCount() const { return WrittenCount.load(std::memory_order_relaxed); }
+	const FString& GetFilePath() const { return FilePath; }
+
+	// FRunnable
+	virtual uint32 Run() override;
+	virtual void Stop() override;
+
+private:
+	uint16 FindOrAddNameId(FName Name);
+	void Drain();
+	void WriteNames();
+
+	FString FilePath;
+	TUniquePtr<IFileHandle> FileHandle;
+	FRunnableThread* Thread = nullptr;
+	std::atomic<bool> bStopRequested { false };
+
+	// 링 버퍼. Head 는 생산자만, Tail 은 소비자만 갱신한다
+	TArray<FGameplayEventRecord> Ring;
+	uint32 RingMask = 0;
+	alignas(PLATFORM_CACHE_LINE_SIZE) std::atomic<uint32> Head { 0 };
+	alignas(PLATFORM_CACHE_LINE_SIZE) std::atomic<uint32> Tail { 0 };
+
+	std::atomic<uint64> DroppedCount { 0 };
+	std::atomic<uint64> WrittenCount { 0 };
+	uint64 LastReportedDropped = 0;
+	double StartTime = 0.0;
+
+	// 새 이름은 드물게만 생기므로 별도 큐로 넘긴다
+	TMap<FName, uint16> NameIds;
+	TQueue<TPair<uint16, FString>, EQueueMode::Spsc> PendingNames;
+
+	// 소비자 스레드가 파일에 쓰기 전에 모아두는 버퍼
+	TArray<FGameplayEventRecord> WriteBuffer;
+};
+
+CH8_UI_API const TCHAR* LexToString(EGameplayEventType Type);
@@ -0,0 +1,51 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameplayEventLog.h"
+#include "Subsystems/GameInstanceSubsystem.h"
+#include "GameplayEventSubsystem.generated.h"
+
+// 히치 스냅샷 등에 쓰는 최근 이벤트 (게임 스레드 전용 메모리 사본)
+struct FRecentGameplayEvent
+{
+	double Time = 0.0;
+	EGameplayEventType Type = EGameplayEventType::None;
+	int32 A = 0;
+	int32 B = 0;
+	float Value = 0.0f;
+	FName Name;
+};
+
+/**
+ * 게임 실행 동안 FGameplayEventLog 를 소유하고 Saved/GameplayEvents/ 아래 이진 파일로 기록한다.
+ * -NoGameplayEventLog 로 끌 수 있으며, 디코딩은 GameplayEventDecode 커맨드렛을 사용한다.
+ */
+UCLASS()
+class CH8_UI_API UGameplayEventSubsystem : public UGameInstanceSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual bool ShouldCreateSubsystem(UObject* Outer) const override;
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void Deinitialize() override;
+
+	void Record(EGameplayEventType Type, int32 A = 0, int32 B = 0, float Value = 0.0f, FName Name = NAME_None);
+
+	// 게임 인스턴스를 직접 갖고 있지 않은 액터에서 호출하기 위한 도우미
+	static void Record(const UObject* WorldContextObject, EGameplayEventType Type, int32 A = 0, int32 B = 0, float Value = 0.0f, FName Name = NAME_None);
+
+	uint64 GetDroppedCount() const;
+
+	// 최근 이벤트를 오래된 것부터 OutEvents 에 추가. Time 은 FPlatformTime::Seconds() 기준
+	void GetRecentEvents(TArray<FRecentGameplayEvent>& OutEvents) const;
+
+protected:
+	TUniquePtr<FGameplayEventLog> EventLog;
+
+	static constexpr int32 NumRecentEvents = 64;
+	FRecentGameplayEvent RecentEvents[NumRecentEvents];
+	uint32 RecentEventCount = 0;
+};
@@ -0,0 +1,23 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/LowLevelMemTracker.h"
+
+// 게임플레이 메모리 추적용 LLM 태그 (-llm 옵션으로 실행했을 때만 집계됨)
+// CH8Items : 아이템 액터 스폰 및 아이템 관련 데이터
+// CH8UI    : HUD, 메뉴 등 UMG 위젯 생성
+// CH8Spawn : 스폰 테이블 조회, 웨이브 통계 등 스폰 부가 데이터
+LLM_DECLARE_TAG_API(CH8Items, CH8_UI_API);
+LLM_DECLARE_TAG_API(CH8UI, CH8_UI_API);
+LLM_DECLARE_TAG_API(CH8Spawn, CH8_UI_API);
+
+namespace CH8LLM
+{
+	// CSV 리포트에서 사용하는 태그 이름 (LLM_DEFINE_TAG의 고유 이름과 동일해야 함)
+	inline const TCHAR* const TagNames[] = { TEXT("CH8Items"), TEXT("CH8UI"), TEXT("CH8Spawn") };
+
+	// 태그의 현재 사용량 (바이트). LLM이 꺼져 있으면 -1
+	CH8_UI_API int64 GetTagAmount(const TCHAR* TagName);
+}
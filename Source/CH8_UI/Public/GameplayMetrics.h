@@ -0,0 +1,31 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+#if !UE_BUILD_SHIPPING
+
+/**
+ * 테스트 장비에서 실행 중인 게임을 외부에서 긁어가는 지표 페이지 (개발 빌드 전용, 기본 꺼짐).
+ * -CH8MetricsPort=9464 로 실행하면 localhost 의 /metrics 에서 텍스트 형식(Prometheus)으로 제공한다.
+ * 게임 코드는 아래 함수로 relaxed 원자 변수만 갱신하고, 문자열은 페이지를 요청받았을 때만 만든다.
+ */
+namespace CH8Metrics
+{
+	// UBaseGameInstance 의 Init/Shutdown 에서 호출. 포트가 지정되지 않았으면 아무것도 하지 않음
+	CH8_UI_API void Startup();
+	CH8_UI_API void Shutdown();
+	CH8_UI_API bool IsEnabled();
+
+	CH8_UI_API void SetLevelAndWave(int32 LevelIndex, int32 WaveIndex);
+	CH8_UI_API void SetTotalScore(int32 TotalScore);
+	CH8_UI_API void RecordWaveSpawnTime(int32 WaveIndex, double Milliseconds);
+	CH8_UI_API void RecordWaveClearTime(int32 WaveIndex, double Milliseconds);
+	CH8_UI_API void RecordPickup();
+	CH8_UI_API void RecordDamage(float Amount);
+	// 아이템 BeginPlay/EndPlay 에서 +1/-1. TypeId 는 UItemEffectSubsystem 이 발급한 ID
+	CH8_UI_API void AddLiveItem(uint16 TypeId, FName ItemType, int32 Delta);
+}
+
+#endif
@@ -0,0 +1,60 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameplayTimingWheel.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "GameplaySchedulerSubsystem.generated.h"
+
+// 예약 항목 종류. 종류마다 처리기 하나가 그 프레임에 만기된 항목을 한 번에 받는다
+enum class EGameplayTimerKind : uint8
+{
+	ItemEffect,		// 지연 효과 (지뢰 퓨즈). Payload: UItemEffectSubsystem 의 대기 효과 인덱스
+	ItemExpiry,		// 아이템 수명 만료. Target: 아이템
+	WaveDeadline,	// 웨이브 제한 시간. Target: 게임 스테이트
+	WaveText,		// 웨이브 시작 문구 숨기기. Target: 게임 스테이트
+	HUDRefresh,		// HUD 갱신 주기. Target: 게임 스테이트
+
+	Num
+};
+
+using FGameplayTimerBatchHandler = TFunction<void(TConstArrayView<FGameplayTimerEvent>)>;
+
+/**
+ * 월드의 게임플레이 마감 시각(퓨즈, 아이템 수명, 웨이브 제한 시간 등)을 하나의 타이밍 휠로 관리한다.
+ * 액터마다 FTimerHandle 을 두지 않고 작은 항목으로 보관하며, 프레임마다 한 번 휠을 진행시켜 만기된 항목을 종류별로 묶어 처리한다.
+ * 시간은 월드 시간(GetTimeSeconds)이라 일시정지 동안 멈춘다.
+ */
+UCLASS()
+class CH8_UI_API UGameplaySchedulerSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	UGameplaySchedulerSubsystem();
+
+	virtual bool ShouldCreateSubsystem(UObject* Outer) const override;
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+
+	void SetHandler(EGameplayTimerKind Kind, FGameplayTimerBatchHandler&& Handler);
+
+	// Delay 초 뒤에 실행
+	FGameplayTimerHandle Schedule(float Delay, EGameplayTimerKind Kind, UObject* Target, uint32 Payload = 0);
+	bool Cancel(FGameplayTimerHandle& Handle, uint32* OutPayload = nullptr) { return Wheel.Cancel(Handle, OutPayload); }
+	bool IsPending(const FGameplayTimerHandle& Handle) const { return Wheel.IsPending(Handle); }
+	// 남은 시간. 대기 중이 아니면 0
+	float GetRemaining(const FGameplayTimerHandle& Handle) const;
+
+	int32 GetNumPending() const { return Wheel.Num(); }
+
+protected:
+	FGameplayTimingWheel Wheel;
+	FGameplayTimerBatchHandler Handlers[static_cast<int32>(EGameplayTimerKind::Num)];
+
+	// 프레임마다 재사용하는 버퍼
+	TArray<FGameplayTimingWheel::FDueTimer> DueTimers;
+	TArray<FGameplayTimerEvent> Batches[static_cast<int32>(EGameplayTimerKind::Num)];
+};
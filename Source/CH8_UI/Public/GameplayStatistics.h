@@ -0,0 +1,23 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * 소크 실행과 밸런스 러너가 같은 표본에서 같은 백분위를 보고하도록 공유하는 통계 함수.
+ */
+namespace CH8Stats
+{
+	// 오름차순 정렬된 배열의 nearest-rank 백분위 값 (Fraction 은 0 ~ 1). 비어 있으면 기본값
+	template <typename T>
+	T SortedPercentile(const TArray<T>& Sorted, float Fraction)
+	{
+		if (Sorted.IsEmpty())
+		{
+			return T();
+		}
+		const int32 Index = FMath::Clamp(FMath::CeilToInt(Fraction * Sorted.Num()) - 1, 0, Sorted.Num() - 1);
+		return Sorted[Index];
+	}
+}
@@ -0,0 +1,86 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/WeakObjectPtrTemplates.h"
+
+// 예약 항목을 가리키는 핸들. 항목이 실행되거나 취소되면 세대 값이 달라져 자동으로 무효가 된다
+struct FGameplayTimerHandle
+{
+	uint32 Index = MAX_uint32;
+	uint32 Generation = 0;
+
+	bool IsSet() const { return Index != MAX_uint32; }
+	void Invalidate() { Index = MAX_uint32; Generation = 0; }
+};
+
+// 만기된 항목 하나 (Kind 별로 묶어서 처리기에 전달)
+struct FGameplayTimerEvent
+{
+	TWeakObjectPtr<UObject> Target;
+	uint32 Payload = 0;
+};
+
+/**
+ * 해시 타이밍 휠. 만기 시각을 Resolution 단위 틱으로 올림해 NumSlots 개의 슬롯 중 (틱 % NumSlots) 칸의 연결 리스트에 넣는다.
+ * 예약/취소는 O(1)이고, Advance 는 지나간 틱의 슬롯만 훑으므로 프레임 비용은 만기된 항목과 같은 슬롯의 먼 미래 항목 수에 비례한다.
+ * 항목은 인덱스 기반 풀에 보관해 예약마다 할당하지 않는다.
+ */
+class CH8_UI_API FGameplayTimingWheel
+{
+public:
+	struct FDueTimer
+	{
+		uint8 Kind = 0;
+		FGameplayTimerEvent Event;
+	};
+
+	explicit FGameplayTimingWheel(double InResolution = 1.0 / 60.0, int32 InNumSlots = 1024);
+
+	// 모든 항목을 지우고 StartTime 부터 다시 시작
+	void Reset(double StartTime);
+
+	FGameplayTimerHandle Schedule(double DueTime, uint8 Kind, UObject* Target, uint32 Payload = 0);
+	// 아직 대기 중이면 취소하고 true. OutPayload 로 예약 시 넘긴 값을 돌려줌. 핸들은 항상 무효화
+	bool Cancel(FGameplayTimerHandle& Handle, uint32* OutPayload = nullptr);
+	bool IsPending(const FGameplayTimerHandle& Handle) const;
+	// 대기 중이 아니면 -1
+	double GetDueTime(const FGameplayTimerHandle& Handle) const;
+
+	// Now 까지 만기된 항목을 OutDue 에 추가하고 풀에 반환
+	void Advance(double Now, TArray<FDueTimer>& OutDue);
+
+	int32 Num() const { return NumPending; }
+	int32 GetCapacity() const { return Entries.Num(); }
+
+private:
+	static constexpr uint32 InvalidIndex = MAX_uint32;
+
+	struct FEntry
+	{
+		double DueTime = 0.0;
+		int64 DueTick = 0;
+		TWeakObjectPtr<UObject> Target;
+		uint32 Payload = 0;
+		uint32 Generation = 0;
+		uint32 Prev = InvalidIndex;
+		uint32 Next = InvalidIndex;
+		uint8 Kind = 0;
+		bool bPending = false;
+	};
+
+	int64 TimeToTick(double Time) const;
+	void Link(uint32 Index);
+	void Unlink(uint32 Index);
+	void Release(uint32 Index);
+	const FEntry* FindPending(const FGameplayTimerHandle& Handle) const;
+
+	double Resolution;
+	TArray<FEntry> Entries;
+	TArray<uint32> FreeIndices;
+	TArray<uint32> SlotHeads;
+	// 마지막으로 처리한 틱
+	int64 CurrentTick = 0;
+	int32 NumPending = 0;
+};
@@ -18,5 +18,5 @@ public:
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Item")
 	float HealAmount;
 
-	virtual void ActivateItem(AActor* Activator) override;
+	virtual void DescribeEffect(FItemEffectRow& OutEffect) const override;
 };
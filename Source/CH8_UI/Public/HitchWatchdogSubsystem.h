@@ -0,0 +1,78 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/GameInstanceSubsystem.h"
+#include "Tickable.h"
+#include "HitchWatchdogSubsystem.generated.h"
+
+DECLARE_LOG_CATEGORY_EXTERN(LogHitchWatchdog, Log, All);
+
+/**
+ * 게임 스레드 프레임 시간이 HitchThresholdMs 를 넘으면 Saved/Hitches/ 에 스냅샷을 남긴다.
+ * 스냅샷: 레벨/웨이브, 종류별 살아있는 아이템 수, 최근 게임플레이 이벤트, 그리고 트레이스 테일 버퍼(메모리 롤링 트레이스)의 .utrace.
+ * 히치 이후 상황도 담기도록 PostHitchSeconds 만큼 기다렸다가 기록하며, 간격과 세션당 개수로 제한한다.
+ * -NoHitchWatchdog 으로 끌 수 있다.
+ */
+UCLASS(config=Game)
+class CH8_UI_API UHitchWatchdogSubsystem : public UGameInstanceSubsystem, public FTickableGameObject
+{
+	GENERATED_BODY()
+
+public:
+	virtual bool ShouldCreateSubsystem(UObject* Outer) const override;
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void Deinitialize() override;
+
+	virtual void Tick(float DeltaTime) override;
+	virtual ETickableTickType GetTickableTickType() const override;
+	virtual TStatId GetStatId() const override;
+
+protected:
+	UPROPERTY(Config)
+	bool bEnabled = true;
+	UPROPERTY(Config)
+	float HitchThresholdMs = 50.0f;
+	// 히치 이후 이만큼 기다렸다가 스냅샷 기록
+	UPROPERTY(Config)
+	float PostHitchSeconds = 1.0f;
+	UPROPERTY(Config)
+	float MinSecondsBetweenSnapshots = 30.0f;
+	UPROPERTY(Config)
+	int32 MaxSnapshotsPerSession = 10;
+	// 맵 로드 직후 프레임은 원래 길기 때문에 무시
+	UPROPERTY(Config)
+	int32 FramesToIgnoreAfterMapLoad = 3;
+	UPROPERTY(Config)
+	bool bCaptureTrace = true;
+
+	struct FPendingSnapshot
+	{
+		double HitchTime = 0.0;
+		double WriteTime = 0.0;
+		float FrameMs = 0.0f;
+		FString MapName;
+		int32 LevelIndex = INDEX_NONE;
+		int32 WaveIndex = INDEX_NONE;
+		int32 CollectedCoins = 0;
+		int32 SpawnedCoins = 0;
+		TArray<TPair<FName, int32>> ItemCounts;
+		int32 DeferredItems = 0;
+	};
+
+	void OnPreLoadMap(const FString& MapName);
+	void OnPostLoadMap(UWorld* LoadedWorld);
+	void CaptureHitch(float FrameMs);
+	void WriteSnapshot(const FPendingSnapshot& Snapshot);
+
+	TOptional<FPendingSnapshot> PendingSnapshot;
+	double LastSnapshotTime = -DBL_MAX;
+	int32 SnapshotCount = 0;
+	int32 SuppressedHitches = 0;
+	int32 IgnoreFrames = 0;
+	bool bLoadingMap = false;
+
+	FDelegateHandle PreLoadMapHandle;
+	FDelegateHandle PostLoadMapHandle;
+};
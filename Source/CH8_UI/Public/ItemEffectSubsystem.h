@@ -0,0 +1,87 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "ItemEffectTypes.h"
+#include "GameplayTimingWheel.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "ItemEffectSubsystem.generated.h"
+
+class ABaseItem;
+
+/**
+ * 아이템 효과 테이블과 효과 처리기.
+ * ItemType 이름마다 FItemTypeId 를 발급하고 효과 정의(FItemEffectRow)를 보관한다.
+ * 종류별 정의는 아이템 클래스 기본값(ABaseItem::DescribeEffect) → ItemEffectTable 의 같은 이름 행 순으로 덮어쓴다.
+ * 스폰 DataTable 행의 Effect* 값은 아이템마다 FItemEffectOverrides 로 들고 있다가 효과를 큐에 넣을 때 함께 복사해 처리 시 적용한다.
+ * 아이템 획득 시 효과는 즉시 적용되지 않고 큐에 쌓였다가 프레임마다 한 번 일괄 처리된다.
+ */
+UCLASS(config=Game)
+class CH8_UI_API UItemEffectSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual bool ShouldCreateSubsystem(UObject* Outer) const override;
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+
+	// 처음 보는 ItemType 이면 Prototype 의 기본 효과로 등록. 이미 있으면 기존 ID 반환
+	FItemTypeId RegisterItemType(FName ItemType, const ABaseItem& Prototype);
+	FItemTypeId FindItemTypeId(FName ItemType) const;
+	// 종류 기본 효과 (스폰 행 덮어쓰기 제외)
+	const FItemEffectRow* GetEffect(FItemTypeId TypeId) const;
+	// 아이템의 스폰 행 덮어쓰기까지 적용한 효과. 등록되지 않은 종류면 false
+	bool ResolveEffect(const ABaseItem& Item, FItemEffectRow& OutEffect) const;
+	FName GetItemTypeName(FItemTypeId TypeId) const;
+	int32 GetNumItemTypes() const { return TypeNames.Num() - 1; }
+	// 웨이브 완료 조건에 포함되는 아이템인지 (효과 정의의 bCountsAsCoin)
+	bool CountsAsCoin(const AActor* Actor) const;
+	// 스폰 전에 클래스 기본 오브젝트로 판정 (처음 보는 종류면 등록)
+	bool CountsAsCoin(TSubclassOf<AActor> ItemClass);
+
+	const TSoftObjectPtr<UDataTable>& GetItemEffectTable() const { return ItemEffectTable; }
+
+	// 다음 처리 때 적용할 효과를 큐에 추가. Delay 가 있는 효과는 스케줄러에 예약하고 그 핸들을 반환
+	FGameplayTimerHandle QueueEffect(FItemTypeId TypeId, const FItemEffectOverrides& Overrides, AActor* Activator, ABaseItem* SourceItem);
+	// 아직 적용되지 않은 지연 효과 취소 (아이템이 먼저 사라진 경우)
+	void CancelEffect(FGameplayTimerHandle& Handle);
+	// Lifetime 초 뒤 아이템 제거 예약
+	FGameplayTimerHandle ScheduleExpiry(ABaseItem* Item, float Lifetime);
+	void CancelExpiry(FGameplayTimerHandle& Handle);
+	int32 GetNumPendingEffects() const { return ReadyEffects.Num() + DelayedEffects.Num(); }
+
+protected:
+	// 디자이너용 효과 테이블 (행 타입 FItemEffectRow, 행 이름 = ItemType)
+	UPROPERTY(Config)
+	TSoftObjectPtr<UDataTable> ItemEffectTable;
+	UPROPERTY(Transient)
+	TObjectPtr<UDataTable> LoadedEffectTable;
+
+	struct FQueuedItemEffect
+	{
+		FItemTypeId TypeId = InvalidItemTypeId;
+		// 아이템이 먼저 사라져도 적용되도록 큐에 넣을 때 복사
+		FItemEffectOverrides Overrides;
+		TWeakObjectPtr<AActor> Activator;
+		TWeakObjectPtr<ABaseItem> SourceItem;
+		FVector Location = FVector::ZeroVector;
+	};
+
+	void ProcessEffects();
+	void OnDelayedEffectsDue(TConstArrayView<FGameplayTimerEvent> Events);
+	void OnItemsExpired(TConstArrayView<FGameplayTimerEvent> Events);
+	void ApplyRadialDamage(const FQueuedItemEffect& Entry, const FItemEffectRow& Effect);
+
+	// ID 로 바로 찾을 수 있도록 배열로 보관 (0번은 비어있는 항목)
+	TArray<FName> TypeNames;
+	TArray<FItemEffectRow> Effects;
+	TMap<FName, FItemTypeId> TypeIds;
+
+	TArray<FQueuedItemEffect> ReadyEffects;
+	// 스케줄러 항목의 Payload 가 가리키는 대기 효과
+	TSparseArray<FQueuedItemEffect> DelayedEffects;
+	TArray<FQueuedItemEffect> ProcessingEffects;
+};
@@ -0,0 +1,87 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/DataTable.h"
+#include "ItemEffectTypes.generated.h"
+
+// 아이템 종류를 가리키는 작은 ID. 월드별 UItemEffectSubsystem 이 ItemType 이름에 대해 발급한다 (0 = 없음)
+using FItemTypeId = uint16;
+constexpr FItemTypeId InvalidItemTypeId = 0;
+
+UENUM(BlueprintType)
+enum class EItemEffectType : uint8
+{
+	None,
+	// 점수 획득 (Magnitude = 점수)
+	Score,
+	// 획득한 플레이어 체력 회복 (Magnitude = 회복량)
+	Heal,
+	// Delay 후 아이템 위치에서 Radius 안의 플레이어에게 데미지 (Magnitude = 데미지)
+	RadialDamage,
+	// Duration 동안 Radius 안의 코인을 끌어당김 (Magnitude = 속도 cm/s)
+	Magnet,
+	// 아래는 UStatusEffectSubsystem 이 Duration 동안 유지하는 지속 효과. 여러 번 얻으면 세기가 합산된다
+	// 초당 체력 회복 (Magnitude = 초당 회복량)
+	Regeneration,
+	// 이동 속도 증가 (Magnitude = 증가 비율, 0.5 = +50%)
+	SpeedBoost,
+	// 점수 아이템 배율 증가 (Magnitude = 증가 비율, 1.0 = 2배)
+	ScoreMultiplier,
+	// 초당 데미지 (Magnitude = 초당 데미지)
+	Poison,
+};
+
+// 아이템 효과 정의. DataTable 로 만들 때 행 이름은 아이템의 ItemType 과 같아야 한다
+USTRUCT(BlueprintType)
+struct FItemEffectRow : public FTableRowBase
+{
+	GENERATED_BODY()
+
+public:
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	EItemEffectType EffectType = EItemEffectType::None;
+	// 효과 세기 (점수, 회복량, 데미지, 속도 등)
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	float Magnitude = 0.0f;
+	// 획득 후 효과가 적용되기까지의 시간
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	float Delay = 0.0f;
+	// 효과 범위
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	float Radius = 0.0f;
+	// 지속 효과의 지속 시간
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	float Duration = 0.0f;
+	// 웨이브 완료 조건의 코인으로 셀지 여부
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	bool bCountsAsCoin = false;
+	// true 면 획득 즉시 아이템 제거, false 면 효과가 적용된 뒤 제거 (지뢰처럼 터질 때까지 남아있는 아이템)
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	bool bDestroyOnActivate = true;
+};
+
+// 스폰 행이 아이템 하나에만 덮어쓰는 효과 값 (0 이하이면 종류 기본값 유지)
+struct FItemEffectOverrides
+{
+	float Radius = 0.0f;
+	float Duration = 0.0f;
+	float Magnitude = 0.0f;
+
+	void ApplyTo(FItemEffectRow& Effect) const
+	{
+		if (Radius > 0.0f)
+		{
+			Effect.Radius = Radius;
+		}
+		if (Duration > 0.0f)
+		{
+			Effect.Duration = Duration;
+		}
+		if (Magnitude > 0.0f)
+		{
+			Effect.Magnitude = Magnitude;
+		}
+	}
+};
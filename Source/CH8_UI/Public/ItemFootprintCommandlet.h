@@ -0,0 +1,59 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "ItemFootprintCommandlet.generated.h"
+
+class ABaseGameState;
+class IAssetRegistry;
+class UDataTable;
+
+/**
+ * 레벨별 스폰 DataTable 의 아이템 클래스가 끌고 들어오는 에셋(메시, 텍스처, 머티리얼 등)의 크기를 헤드리스로 점검한다.
+ * 아이템마다 하드 참조 의존성 전체를 따라가 디스크 크기, 로드 후 예상 메모리, 첫 로드 시간을 재고
+ * 레벨마다 아이템 합계와 맵이 이미 참조하지 않는 아이템 전용 크기를 CSV 로 출력한다. 예산을 넘으면 실패(1)를 반환한다.
+ * 사용법: UnrealEditor-Cmd CH8_UI.uproject -run=ItemFootprint -unattended -nullrhi [-Out=<파일.csv>]
+ *         [-MaxItemDiskMB=64] [-MaxItemResidentMB=64] [-MaxLevelResidentMB=256]
+ */
+UCLASS(config=Game)
+class CH8_UI_API UItemFootprintCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+	UItemFootprintCommandlet();
+
+	virtual int32 Main(const FString& Params) override;
+
+protected:
+	// 레벨 순서대로의 스폰 DataTable (ASpawnVolume::ItemDataTable 과 같은 테이블)
+	UPROPERTY(Config)
+	TArray<TSoftObjectPtr<UDataTable>> LevelItemTables;
+	// LevelMapNames 를 읽을 게임 스테이트 클래스
+	UPROPERTY(Config)
+	TSoftClassPtr<ABaseGameState> GameStateClass;
+
+	// 예산 (MB). 0 이하이면 검사하지 않음
+	UPROPERTY(Config)
+	float MaxItemDiskMB = 0.0f;
+	UPROPERTY(Config)
+	float MaxItemResidentMB = 0.0f;
+	UPROPERTY(Config)
+	float MaxLevelResidentMB = 0.0f;
+
+	struct FPackageFootprint
+	{
+		int64 DiskBytes = 0;
+		int64 ResidentBytes = 0;
+	};
+
+	// 스크립트(네이티브) 패키지를 뺀 하드 참조 의존성 전체
+	static void GatherClosure(const IAssetRegistry& AssetRegistry, FName RootPackage, TSet<FName>& OutPackages);
+	const FPackageFootprint& GetPackageFootprint(const IAssetRegistry& AssetRegistry, FName PackageName);
+	FPackageFootprint SumFootprint(const IAssetRegistry& AssetRegistry, const TSet<FName>& Packages);
+	static FName FindMapPackage(const IAssetRegistry& AssetRegistry, FName MapName);
+
+	TMap<FName, FPackageFootprint> PackageFootprints;
+};
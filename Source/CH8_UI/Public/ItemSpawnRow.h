@@ -21,4 +21,17 @@ public:
 	// 이 아이템의 스폰 확률
 	UPROPERTY(EditAnywhere, BlueprintReadWrite)
 	float SpawnChance;
+	// 아이템 효과 설정 (0 이하이면 아이템 클래스의 기본값 사용)
+	// 효과 범위 (예: 자석이 코인을 끌어당기는 반경)
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Effect")
+	float EffectRadius = 0.0f;
+	// 효과 지속 시간
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Effect")
+	float EffectDuration = 0.0f;
+	// 효과 세기 (예: 자석이 코인을 끌어당기는 속도)
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Effect")
+	float EffectMagnitude = 0.0f;
+	// 스폰 후 이 시간(초)이 지나면 사라짐 (0 이하이면 사라지지 않음). 사라진 코인은 웨이브 완료 조건에서 빠진다
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Lifetime")
+	float Lifetime = 0.0f;
 };
\ No newline at end of file
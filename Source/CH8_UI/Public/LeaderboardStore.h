@@ -0,0 +1,115 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/CriticalSection.h"
+#include "Tasks/Pipe.h"
+
+class IFileHandle;
+class IMappedFileHandle;
+class IMappedFileRegion;
+
+// 파일에 그대로 들어가는 한 판의 기록 (레이아웃을 바꾸면 FileVersion 을 올릴 것)
+struct FLeaderboardEntry
+{
+	static constexpr int32 MaxLevels = 4;
+
+	int64 UtcTicks = 0;			// 게임 오버 시각
+	int32 TotalScore = 0;
+	uint32 Seed = 0;			// 판 시작 시 난수 시드
+	float DurationSec = 0.0f;
+	uint8 LevelsPlayed = 0;		// 진행한 레벨 수 (LevelScores 의 유효 개수)
+	uint8 Flags = 0;			// EFlags
+	uint16 Reserved = 0;
+	int32 LevelScores[MaxLevels] = {};
+
+	enum EFlags : uint8
+	{
+		GameCleared = 1 << 0,
+	};
+};
+static_assert(sizeof(FLeaderboardEntry) == 40, "Leaderboard entry layout is part of the file format");
+
+/**
+ * 로컬 리더보드. 모든 판을 추가 전용 이진 파일에 쌓고, 전체/레벨별 상위 K 개를 작은 색인 파일로 유지한다.
+ * 시작 시에는 색인만 읽고 데이터 파일은 메모리 매핑만 하므로 기록 수와 관계없이 상위 목록을 바로 보여줄 수 있다.
+ * 추가와 색인 갱신은 태스크 파이프에서 순서대로 처리되어 게임 스레드는 기다리지 않는다.
+ *
+ * 데이터 파일: FDataHeader 뒤에 FLeaderboardEntry 가 기록 순서대로 이어진다. 끝이 잘린 기록은 무시된다.
+ * 색인 파일: FIndexHeader 뒤에 목록(전체, 레벨 0..MaxLevels-1)마다 uint32 개수 + FIndexSlot * Capacity.
+ *           색인이 덮은 기록 수(EntryCount)보다 데이터가 많으면 뒤쪽만 훑어 따라잡고, 맞지 않으면 전체를 다시 만든다.
+ */
+class CH8_UI_API FLeaderboardStore
+{
+public:
+	static constexpr uint32 DataMagic = 0x4C384843;		// "CH8L"
+	static constexpr uint32 IndexMagic = 0x49384843;	// "CH8I"
+	static constexpr uint32 FileVersion = 1;
+	static constexpr int32 NumLists = 1 + FLeaderboardEntry::MaxLevels;
+
+	struct FDataHeader
+	{
+		uint32 Magic = DataMagic;
+		uint32 Version = FileVersion;
+		uint32 EntrySize = sizeof(FLeaderboardEntry);
+		uint32 Reserved = 0;
+	};
+
+	struct FIndexHeader
+	{
+		uint32 Magic = IndexMagic;
+		uint32 Version = FileVersion;
+		uint32 EntrySize = sizeof(FLeaderboardEntry);
+		uint32 Capacity = 0;
+		uint64 EntryCount = 0;
+	};
+
+	struct FIndexSlot
+	{
+		int32 Score = 0;
+		uint32 Ordinal = 0;		// 데이터 파일에서의 기록 순번
+	};
+
+	FLeaderboardStore(const FString& InDirectory, int32 InCapacity);
+	~FLeaderboardStore();
+
+	// 색인을 읽고 데이터 파일을 매핑. 색인이 없거나 맞지 않으면 재구성을 파이프에 넣는다
+	void Open();
+	// 게임 스레드에서 호출. 파일 쓰기와 색인 갱신은 파이프에서
+	void Append(const FLeaderboardEntry& Entry);
+	// 대기 중인 쓰기가 모두 끝날 때까지 기다림 (종료 시)
+	void Flush();
+
+	// 점수 높은 순. LevelIndex 가 INDEX_NONE 이면 전체 점수, 아니면 그 레벨 점수 기준
+	void GetTop(int32 Count, TArray<FLeaderboardEntry>& OutEntries, int32 LevelIndex = INDEX_NONE) const;
+	uint64 GetNumEntries() const;
+
+private:
+	bool MapData();
+	bool ReadIndex();
+	bool ReadEntry(uint32 Ordinal, FLeaderboardEntry& OutEntry) const;
+	void WriteIndex() const;
+
+	// 파이프 작업
+	void AppendOnPipe(const FLeaderboardEntry& Entry, uint64 Ordinal);
+	void RebuildOnPipe();
+
+	FString DataPath;
+	FString IndexPath;
+	int32 Capacity = 0;
+
+	UE::Tasks::FPipe WritePipe { TEXT("LeaderboardWrites") };
+	// 파이프에서만 사용
+	TUniquePtr<IFileHandle> WriteHandle;
+
+	// 아래는 Lock 으로 보호 (게임 스레드 조회 ↔ 파이프 갱신)
+	mutable FCriticalSection Lock;
+	TArray<FIndexSlot> Lists[NumLists];
+	uint64 NumEntries = 0;
+	// 매핑된 데이터 (매핑 이후 추가된 기록은 TailEntries 에)
+	TUniquePtr<IMappedFileHandle> MappedFile;
+	TUniquePtr<IMappedFileRegion> MappedRegion;
+	uint64 NumMappedEntries = 0;
+	TArray<FLeaderboardEntry> TailEntries;
+};
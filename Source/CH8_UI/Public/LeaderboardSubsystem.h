@@ -0,0 +1,40 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "LeaderboardStore.h"
+#include "Subsystems/GameInstanceSubsystem.h"
+#include "LeaderboardSubsystem.generated.h"
+
+class UBaseGameInstance;
+
+/**
+ * 로컬 리더보드. 게임 오버마다 한 판을 Saved/Leaderboard/ 의 FLeaderboardStore 에 추가하고 메인 메뉴에 상위 기록을 제공한다.
+ * 소크 테스트(-SoakRuns) 중에는 만들지 않는다.
+ */
+UCLASS(config=Game)
+class CH8_UI_API ULeaderboardSubsystem : public UGameInstanceSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual bool ShouldCreateSubsystem(UObject* Outer) const override;
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void Deinitialize() override;
+
+	// 게임 인스턴스에 쌓인 이번 판 기록을 추가 (파일 쓰기는 백그라운드)
+	void RecordRun(const UBaseGameInstance& GameInstance, bool bGameCleared);
+
+	// 점수 높은 순. LevelIndex 가 INDEX_NONE 이면 총점 기준
+	void GetTopEntries(int32 Count, TArray<FLeaderboardEntry>& OutEntries, int32 LevelIndex = INDEX_NONE) const;
+	// 메인 메뉴용 상위 Count 개 문자열
+	FString FormatTopEntries(int32 Count) const;
+
+protected:
+	// 전체/레벨별로 색인에 유지할 상위 기록 수 (DefaultGame.ini 의 [/Script/CH8_UI.LeaderboardSubsystem])
+	UPROPERTY(Config)
+	int32 IndexCapacity = 100;
+
+	TUniquePtr<FLeaderboardStore> Store;
+};
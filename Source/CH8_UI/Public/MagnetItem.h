@@ -0,0 +1,34 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "BaseItem.h"
+#include "MagnetItem.generated.h"
+
+/**
+ * 자석 아이템. 획득하면 일정 시간 동안 플레이어 주변의 코인을 끌어당긴다.
+ * 끌려온 코인은 플레이어에게 도착하면 ActivateItem 으로 정상 획득 처리된다.
+ * 스폰 DataTable 행의 EffectRadius / EffectDuration / EffectMagnitude 로 반경, 지속 시간, 속도를 덮어쓸 수 있다.
+ */
+UCLASS()
+class CH8_UI_API AMagnetItem : public ABaseItem
+{
+	GENERATED_BODY()
+
+public:
+	AMagnetItem();
+
+	virtual void DescribeEffect(FItemEffectRow& OutEffect) const override;
+
+protected:
+	// 코인을 끌어당기는 반경
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Magnet")
+	float MagnetRadius;
+	// 효과 지속 시간 (초)
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Magnet")
+	float MagnetDuration;
+	// 코인이 날아오는 속도 (cm/s)
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Magnet")
+	float PullSpeed;
+};
@@ -16,6 +16,8 @@ class CH8_UI_API AMineItem : public ABaseItem
 public:
 	AMineItem();
 
+	virtual void DescribeEffect(FItemEffectRow& OutEffect) const override;
+
 protected:
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Item|Component")
 	USphereComponent* ExplosionCollision;
@@ -29,11 +31,4 @@ protected:
 	// 폭발 데미지
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Mine")
 	int ExplosionDamage;
-    
-	// 지뢰 발동 여부
-	FTimerHandle ExplosionTimerHandle;
-
-	virtual void ActivateItem(AActor* Activator) override;
-
-	void Explode();
 };
\ No newline at end of file
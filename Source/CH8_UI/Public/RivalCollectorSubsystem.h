@@ -0,0 +1,117 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "RivalCollectorSubsystem.generated.h"
+
+class ACoinItem;
+class ARivalCollectorsActor;
+class UStaticMesh;
+
+DECLARE_LOG_CATEGORY_EXTERN(LogRivals, Log, All);
+
+/**
+ * 플레이어와 코인을 두고 경쟁하는 라이벌 수집가. 라이벌은 액터가 아니라 나란한 배열(위치, 목표, 점수)의 한 항목이며,
+ * 프레임당 한 번 UCoinSpatialIndexSubsystem 으로 주변 코인을 찾아 다른 라이벌이 노리지 않는 가장 가까운 코인을 고르고
+ * 모든 라이벌을 한 루프에서 직선으로 움직인다 (내비게이션 없이 떠서 이동).
+ * 코인에 닿으면 ARivalCollectorsActor 를 Activator 로 ActivateItem 을 호출하므로 웨이브 코인 완료는 플레이어와 같은 경로로 처리되고,
+ * 점수는 플레이어 점수 대신 라이벌별로 따로 쌓는다. 그리기는 ARivalCollectorsActor 의 인스턴스 메시 하나로 한다.
+ * 라이벌 수는 DefaultGame.ini 의 NumRivals 또는 -CH8Rivals=N (기본 0 = 없음).
+ */
+UCLASS(config=Game)
+class CH8_UI_API URivalCollectorSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual bool ShouldCreateSubsystem(UObject* Outer) const override;
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+
+	// ABaseGameState 가 레벨을 시작할 때 호출. 설정된 수만큼 라이벌 생성
+	void OnLevelStarted();
+	// 기존 라이벌을 모두 지우고 Count 만큼 스폰 볼륨 안에 새로 만듦
+	void SpawnRivals(int32 Count);
+	// ABaseGameState 가 게임 오버 때 호출. 라이벌을 그 자리에 멈추고 더는 코인을 줍지 않음 (다음 SpawnRivals 까지)
+	void OnGameOver();
+
+	int32 GetNumRivals() const { return PosX.Num(); }
+	int32 GetTotalRivalScore() const { return TotalRivalScore; }
+	int32 GetBestRivalScore() const;
+	// 라이벌 갱신의 게임 스레드 비용 (ms)
+	double GetAverageTickMs() const { return AverageTickMs; }
+
+#if !UE_BUILD_SHIPPING
+	// 콘솔 명령용 (ch8.RivalBenchmark). 라이벌 수를 Step 씩 늘려가며 단계마다 FramesPerStep 프레임의 평균 갱신 비용을 잰다
+	void DebugStartBenchmark(int32 MaxRivals, int32 Step, int32 FramesPerStep);
+#endif
+
+protected:
+	void UpdateRivals(float DeltaTime);
+	void AssignTargets();
+	void CollectCoin(int32 RivalIndex, ACoinItem* Coin);
+	void UpdateInstances();
+	ARivalCollectorsActor* GetOrCreateRenderActor();
+
+	// 레벨 시작 시 생성할 라이벌 수 (-CH8Rivals=N 으로 덮어씀)
+	UPROPERTY(Config)
+	int32 NumRivals = 0;
+	// 이동 속도 (cm/s)
+	UPROPERTY(Config)
+	float MoveSpeed = 450.0f;
+	// 코인을 찾는 반경
+	UPROPERTY(Config)
+	float SearchRadius = 3000.0f;
+	// 코인 중심에서 이 거리 안에 들어오면 획득
+	UPROPERTY(Config)
+	float CollectDistance = 100.0f;
+	// 목표가 있는 라이벌도 이 간격마다 더 가까운 코인이 있는지 다시 찾음
+	UPROPERTY(Config)
+	float RetargetInterval = 1.0f;
+	// 한 프레임에 목표를 찾는 라이벌 수 (공간 질의 비용 분산)
+	UPROPERTY(Config)
+	int32 RetargetsPerFrame = 32;
+	// 모든 라이벌을 그리는 인스턴스 메시와 크기
+	UPROPERTY(Config)
+	TSoftObjectPtr<UStaticMesh> RivalMesh;
+	UPROPERTY(Config)
+	FVector RivalScale = FVector(0.5f, 0.5f, 0.5f);
+
+	UPROPERTY(Transient)
+	TObjectPtr<ARivalCollectorsActor> RenderActor;
+
+	// 라이벌별 상태 (항목 i 는 모든 배열의 i 번째)
+	TArray<float> PosX, PosY, PosZ;
+	TArray<TWeakObjectPtr<ACoinItem>> Targets;
+	TArray<float> RetargetTimers;
+	TArray<int32> Scores;
+	int32 TotalRivalScore = 0;
+	int32 NextRetarget = 0;
+
+	// 프레임마다 재사용하는 버퍼
+	TSet<const ACoinItem*> ClaimedCoins;
+	TArray<ACoinItem*> QueryResult;
+	TArray<FTransform> InstanceTransforms;
+
+	double AverageTickMs = 0.0;
+	bool bFrozen = false;
+
+#if !UE_BUILD_SHIPPING
+	struct FBenchmarkState
+	{
+		bool bRunning = false;
+		int32 MaxRivals = 0;
+		int32 Step = 0;
+		int32 FramesPerStep = 0;
+		int32 RestoreCount = 0;
+		int32 FrameInStep = 0;
+		double StepTotalMs = 0.0;
+		TArray<TPair<int32, double>> Results;
+	};
+	FBenchmarkState Benchmark;
+
+	void AdvanceBenchmark(double TickMs);
+#endif
+};
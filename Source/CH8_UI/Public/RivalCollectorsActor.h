@@ -0,0 +1,31 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameFramework/Actor.h"
+#include "RivalCollectorsActor.generated.h"
+
+class UInstancedStaticMeshComponent;
+
+/**
+ * 라이벌 수집가 전체를 그리는 인스턴스 메시 하나와, 라이벌이 코인을 획득할 때 넘기는 Activator 역할을 하는 액터.
+ * URivalCollectorSubsystem 이 레벨마다 하나 만든다. 라이벌 하나가 인스턴스 하나에 대응한다.
+ */
+UCLASS(NotPlaceable, Transient)
+class CH8_UI_API ARivalCollectorsActor : public AActor
+{
+	GENERATED_BODY()
+
+public:
+	ARivalCollectorsActor();
+
+	// 라이벌 획득을 구별하는 태그 (ABaseItem::ActivateItem, UItemEffectSubsystem 에서 확인)
+	static const FName RivalTag;
+
+	UInstancedStaticMeshComponent* GetInstances() const { return Instances; }
+
+protected:
+	UPROPERTY(VisibleAnywhere, Category = "Rival")
+	TObjectPtr<UInstancedStaticMeshComponent> Instances;
+};
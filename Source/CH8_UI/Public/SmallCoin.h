@@ -15,6 +15,4 @@ class CH8_UI_API ASmallCoin : public ACoinItem
 	GENERATED_BODY()
 public:
 	ASmallCoin();
-
-	virtual void ActivateItem(AActor* Activator) override;
 };
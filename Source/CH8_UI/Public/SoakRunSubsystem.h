@@ -0,0 +1,103 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/GameInstanceSubsystem.h"
+#include "Tickable.h"
+#include "SoakRunSubsystem.generated.h"
+
+DECLARE_LOG_CATEGORY_EXTERN(LogSoakRun, Log, All);
+
+// 웨이브 하나에 허용되는 성능 예산. LevelIndex / WaveIndex 가 INDEX_NONE 이면 모든 레벨/웨이브에 해당
+USTRUCT()
+struct FSoakWaveBudget
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	int32 LevelIndex = INDEX_NONE;
+	UPROPERTY()
+	int32 WaveIndex = INDEX_NONE;
+	UPROPERTY()
+	float MaxP95FrameMs = 33.3f;
+	UPROPERTY()
+	float MaxP99FrameMs = 50.0f;
+	UPROPERTY()
+	int32 MaxHitches = 3;
+	UPROPERTY()
+	float MaxMemoryMB = 4096.0f;
+};
+
+/**
+ * 헤드리스 소크 테스트 진행자.
+ * -SoakRuns=N 으로 실행하면 생성되며, 코인 봇(UCoinBotSubsystem)으로 BasicLevel → IntermediateLevel → AdvancedLevel 을 N회 반복한다.
+ * 웨이브마다 게임 스레드 프레임 시간 백분위, 히치 수, 메모리 최고치를, 레벨마다 전환 시간을 측정해 예산과 비교하고
+ * 결과를 Saved/Soak/SoakResults.csv 에 남긴 뒤 예산 초과가 있으면 종료 코드 1 로 종료한다.
+ * 예: CH8_UI -nullrhi -unattended -SoakRuns=5
+ */
+UCLASS(config=Game)
+class CH8_UI_API USoakRunSubsystem : public UGameInstanceSubsystem, public FTickableGameObject
+{
+	GENERATED_BODY()
+
+public:
+	static bool IsSoakRequested();
+
+	virtual bool ShouldCreateSubsystem(UObject* Outer) const override;
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void Deinitialize() override;
+
+	virtual void Tick(float DeltaTime) override;
+	virtual ETickableTickType GetTickableTickType() const override;
+	virtual TStatId GetStatId() const override;
+
+	void OnWaveStarted(int32 LevelIndex, int32 WaveIndex);
+	void OnWaveEnded(const TCHAR* Outcome);
+	void OnGameOver(bool bAllLevelsCleared);
+
+protected:
+	// 웨이브별 예산 (DefaultGame.ini 의 [/Script/CH8_UI.SoakRunSubsystem])
+	UPROPERTY(Config)
+	TArray<FSoakWaveBudget> WaveBudgets;
+	UPROPERTY(Config)
+	FSoakWaveBudget DefaultWaveBudget;
+	// 이 시간보다 긴 프레임을 히치로 계산
+	UPROPERTY(Config)
+	float HitchThresholdMs = 100.0f;
+	// 레벨 전환(OpenLevel → 맵 로드 완료) 허용 시간
+	UPROPERTY(Config)
+	float MaxLevelTransitionSec = 15.0f;
+
+	void OnPreLoadMap(const FString& MapName);
+	void OnPostLoadMap(UWorld* LoadedWorld);
+	void StartNextRun();
+	void Finish();
+
+	const FSoakWaveBudget& FindBudget(int32 LevelIndex, int32 WaveIndex) const;
+	void AppendResultRow(const FString& Row);
+
+	int32 RunsRequested = 1;
+	int32 RunsStarted = 0;
+	int32 RunsCompleted = 0;
+	int32 RunsCleared = 0;
+	int32 BudgetFailures = 0;
+	bool bFinished = false;
+
+	// 현재 웨이브 측정값
+	bool bInWave = false;
+	int32 WaveLevelIndex = 0;
+	int32 WaveIndex = 0;
+	TArray<float> FrameTimesMs;
+	int32 HitchCount = 0;
+	uint64 PeakUsedPhysical = 0;
+	double NextMemorySampleTime = 0.0;
+
+	// 레벨 전환 측정
+	double TransitionStartTime = 0.0;
+	FString TransitionMapName;
+
+	FDelegateHandle PreLoadMapHandle;
+	FDelegateHandle PostLoadMapHandle;
+	FTimerHandle NextRunTimerHandle;
+};
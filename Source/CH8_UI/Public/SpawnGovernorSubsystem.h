@@ -0,0 +1,79 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "SpawnGovernorSubsystem.generated.h"
+
+DECLARE_LOG_CATEGORY_EXTERN(LogSpawnGovernor, Log, All);
+
+/**
+ * 프레임 예산에 맞춰 동시에 살아있는 아이템 수를 제한한다.
+ * 프레임 비용(게임/렌더 스레드 중 긴 쪽)과 살아있는 아이템 수를 지수 가중 최소제곱으로 회귀해 아이템 하나의 비용을 추정하고,
+ * TargetFrameMs 안에 들어오는 최대 아이템 수를 한도로 삼는다.
+ * 실제 스폰은 USpawnRecordSubsystem 이 GetSpawnBudget() 만큼씩 하며, 한도를 넘는 아이템은 기록으로 남아 자리가 나기를 기다린다.
+ */
+UCLASS(config=Game)
+class CH8_UI_API USpawnGovernorSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual bool ShouldCreateSubsystem(UObject* Outer) const override;
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+
+	// 이번에 스폰해도 되는 아이템 수. 웨이브 시작 시에는 프레임당 제한 없이 한도까지 허용
+	int32 GetSpawnBudget(bool bWaveStart) const;
+
+	// ABaseItem 의 BeginPlay/EndPlay 에서 호출
+	void NotifyItemSpawned() { LiveItems++; }
+	void NotifyItemRemoved() { LiveItems = FMath::Max(LiveItems - 1, 0); }
+
+	int32 GetLiveItems() const { return LiveItems; }
+	int32 GetLiveItemCap() const { return LiveItemCap; }
+	float GetCostPerItemMs() const { return CostPerItemMs; }
+	float GetBaseFrameMs() const { return BaseFrameMs; }
+	float GetSmoothedFrameMs() const { return SmoothedFrameMs; }
+
+protected:
+	void AddSample(float FrameMs);
+	void UpdateCap();
+
+	// 목표 프레임 비용 (ms)
+	UPROPERTY(Config)
+	float TargetFrameMs = 16.6f;
+	// 예산과 관계없이 항상 허용하는 아이템 수
+	UPROPERTY(Config)
+	int32 MinLiveItems = 20;
+	UPROPERTY(Config)
+	int32 MaxLiveItems = 200;
+	// 보류분을 한 프레임에 스폰하는 최대 수 (스폰 자체의 히치 방지)
+	UPROPERTY(Config)
+	int32 MaxSpawnsPerFrame = 4;
+	// 회귀 샘플의 반감기 (프레임)
+	UPROPERTY(Config)
+	float SampleHalfLifeFrames = 120.0f;
+	// 프레임 시간 지수 이동 평균 계수
+	UPROPERTY(Config)
+	float FrameSmoothing = 0.05f;
+	// 한도 변화가 이 이상일 때만 로그
+	UPROPERTY(Config)
+	int32 CapLogThreshold = 5;
+
+	int32 LiveItems = 0;
+	int32 LiveItemCap = 0;
+	int32 LastLoggedCap = 0;
+
+	// 지수 가중 최소제곱 누적값 (x = 살아있는 아이템 수, y = 프레임 비용 ms)
+	double SumW = 0.0;
+	double SumX = 0.0;
+	double SumY = 0.0;
+	double SumXX = 0.0;
+	double SumXY = 0.0;
+
+	float SmoothedFrameMs = 0.0f;
+	float BaseFrameMs = 0.0f;
+	float CostPerItemMs = 0.0f;
+};
@@ -0,0 +1,124 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "SpawnRecordSubsystem.generated.h"
+
+class ABaseItem;
+class ASpawnVolume;
+struct FItemSpawnRow;
+
+DECLARE_LOG_CATEGORY_EXTERN(LogSpawnRecords, Log, All);
+
+/**
+ * 웨이브 아이템을 액터가 아닌 가벼운 기록(행, 위치, 상태)으로 보관하고, 필요할 때만 액터로 만든다.
+ * 기록은 월드 파티션 스트리밍 셀 크기의 격자로 묶이며, 격자 칸이 로드(활성화)되어 있고 스폰 거버너의 예산이 있을 때 액터가 된다.
+ * 칸이 언로드되면 그 안의 액터는 현재 위치와 남은 수명을 기록에 되돌려 놓고 제거한다. 획득/폭발/만료된 기록은 다시 만들어지지 않는다.
+ * 웨이브의 코인 수는 기록 생성 시점에 정해지므로 액터화/기록화는 완료 판정에 영향이 없다.
+ * 월드 파티션이 아닌 맵에서는 모든 칸이 로드된 것으로 본다.
+ * 볼륨이 근접 고리(ASpawnVolume::UsesProximityRing)를 쓰면 플레이어 주변 고리 안의 기록만 액터가 되고 고리 밖으로 멀어진 액터는 기록으로 돌아간다.
+ * 이때 기록으로 있는 동안에도 수명은 줄어들어, 만료 시점은 처음부터 액터였던 것과 같다.
+ */
+UCLASS(config=Game)
+class CH8_UI_API USpawnRecordSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual bool ShouldCreateSubsystem(UObject* Outer) const override;
+	virtual void OnWorldBeginPlay(UWorld& InWorld) override;
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+
+	// 웨이브 아이템을 기록으로 만들고, 로드된 칸의 아이템은 예산 안에서 바로 스폰. Locations 는 WaveItems 와 같은 순서
+	void StartWave(ASpawnVolume* SpawnVolume, TConstArrayView<const FItemSpawnRow*> WaveItems, TConstArrayView<FVector> Locations);
+	// 모든 기록 삭제. 이후 기존 액터의 EndPlay 는 무시됨
+	void Clear();
+
+	// ABaseItem::EndPlay 에서 호출. 기록화 때문이 아닌 제거면 기록을 완료 처리
+	void OnItemEndPlay(ABaseItem* Item, int32 RecordIndex, uint32 RecordSerial);
+
+	int32 GetNumRecords() const { return Records.Num(); }
+	// 아직 액터가 아닌 기록 (예산 대기 + 언로드된 칸)
+	int32 GetNumPending() const { return NumPending; }
+	int32 GetNumUnloadedCells() const { return NumUnloadedCells; }
+	// 지금 액터로 있는 기록 수와 이번 웨이브의 최고치
+	int32 GetNumLive() const { return NumLive; }
+	int32 GetPeakLive() const { return PeakLive; }
+
+protected:
+	enum class ERecordState : uint8
+	{
+		Pending,	// 액터로 만들어지기를 기다림
+		Live,		// 액터가 있음
+		Done,		// 획득/제거됨
+	};
+
+	struct FItemSpawnRecord
+	{
+		const FItemSpawnRow* Row = nullptr;
+		FVector Location = FVector::ZeroVector;
+		// 0 이하이면 수명 없음
+		float RemainingLifetime = 0.0f;
+		TWeakObjectPtr<ABaseItem> Actor;
+		FIntPoint Cell = FIntPoint::ZeroValue;
+		ERecordState State = ERecordState::Pending;
+		// 기록 상태에서 만료되거나 스폰에 실패할 때 웨이브 코인 수에서 빼야 하는지
+		bool bCountsAsCoin = false;
+	};
+
+	struct FRecordCell
+	{
+		// CellRecordIndices 에서 이 칸의 기록 인덱스가 차지하는 구간
+		int32 FirstRecord = 0;
+		int32 NumRecords = 0;
+		// CellOrder 에서의 위치
+		int32 OrderIndex = 0;
+		FVector Center = FVector::ZeroVector;
+		int32 NumPending = 0;
+		bool bLoaded = false;
+	};
+
+	FIntPoint GetCellCoord(const FVector& Location) const;
+	TConstArrayView<int32> GetCellRecords(const FRecordCell& Cell) const { return MakeArrayView(CellRecordIndices.GetData() + Cell.FirstRecord, Cell.NumRecords); }
+	bool IsCellLoaded(const FRecordCell& Cell) const;
+	void UpdateCellStates(bool bAllCells);
+	void Dematerialize(FRecordCell& Cell);
+	bool DematerializeRecord(FItemSpawnRecord& Record, FRecordCell& Cell);
+	int32 Materialize(int32 Budget);
+	// 근접 고리: 플레이어 위치 갱신, 멀어진 액터 기록화, 기록 상태 수명 진행
+	void UpdateProximity(float DeltaTime);
+	bool IsNearPlayer(const FVector& Location, float RadiusSquared) const;
+
+	// 월드 파티션 런타임 격자의 셀 크기와 맞추면 칸 하나가 스트리밍 셀 하나에 대응
+	UPROPERTY(Config)
+	float CellSize = 25600.0f;
+	// 프레임마다 로드 상태를 확인하는 칸 수 (스트리밍 질의 비용 분산)
+	UPROPERTY(Config)
+	int32 CellsCheckedPerFrame = 8;
+
+	TWeakObjectPtr<ASpawnVolume> Volume;
+	// 웨이브마다 비우기만 하고 다시 채워서 준비 웨이브 이후에는 할당이 없도록 칸별 목록 대신 한 배열에 칸 순서대로 보관
+	TArray<FItemSpawnRecord> Records;
+	TArray<int32> CellRecordIndices;
+	TMap<FIntPoint, FRecordCell> Cells;
+	TArray<FIntPoint> CellOrder;
+	int32 NextCellToCheck = 0;
+	int32 NumPending = 0;
+	int32 NumUnloadedCells = 0;
+	int32 NumLive = 0;
+	int32 PeakLive = 0;
+	// 스폰에 실패해 웨이브 코인 수에서 빼야 할 코인 (웨이브 규칙이 시작된 뒤 Tick 에서 알림)
+	int32 FailedCoins = 0;
+	// 근접 고리 설정 (웨이브 시작 시 볼륨에서 복사)
+	bool bUseProximityRing = false;
+	float MaterializeRadiusSquared = 0.0f;
+	float DematerializeRadiusSquared = 0.0f;
+	TArray<FVector, TInlineAllocator<4>> PlayerLocations;
+	// Clear 할 때마다 증가. 지난 웨이브 액터의 EndPlay 를 걸러냄
+	uint32 Serial = 1;
+	bool bUseStreaming = false;
+	bool bDematerializing = false;
+};
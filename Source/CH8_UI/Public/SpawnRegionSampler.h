@@ -0,0 +1,44 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * 스폰 영역을 삼각형 목록과 면적 누적표로 미리 만들어 두고 균일하게 점을 뽑는다.
+ * 뽑기는 누적표 이진 탐색으로 삼각형을 고른 뒤 무게중심 좌표 한 번이라 런타임 기하 계산이 없다.
+ * 만든 뒤에는 읽기 전용이므로 웨이브 계획 태스크가 공유 포인터로 함께 읽는다.
+ */
+class CH8_UI_API FSpawnRegionSampler
+{
+public:
+	void Reset();
+
+	// 면적이 0 인 삼각형은 버림
+	void AddTriangle(const FVector& A, const FVector& B, const FVector& C);
+	// 단순 다각형(자기 교차 없음, 볼록/오목 모두)을 XY 평면에서 귀 자르기로 나눔. 실패하면 false (그때까지의 삼각형은 남음)
+	bool AddPolygon(TArrayView<const FVector> Points);
+
+	// 뽑은 점을 표면 위 0 ~ Height 높이로 올림 (상자 볼륨의 높이 범위와 같은 역할)
+	void SetHeight(float InHeight) { Height = FMath::Max(InHeight, 0.0f); }
+
+	bool IsEmpty() const { return CumulativeArea.IsEmpty(); }
+	int32 GetNumTriangles() const { return CumulativeArea.Num(); }
+	double GetTotalArea() const { return CumulativeArea.IsEmpty() ? 0.0 : CumulativeArea.Last(); }
+	const FBox& GetBounds() const { return Bounds; }
+
+	// 게임 스레드용 (FMath 전역 난수)
+	FVector GetRandomPoint() const;
+	// 워커 스레드용
+	FVector GetRandomPoint(FRandomStream& Stream) const;
+
+private:
+	FVector SampleAt(float TriangleRand, float U, float V, float HeightRand) const;
+
+	// 삼각형 i 의 꼭짓점은 Corners[3i .. 3i+2]
+	TArray<FVector> Corners;
+	// 삼각형 i 까지의 면적 합
+	TArray<double> CumulativeArea;
+	FBox Bounds = FBox(ForceInit);
+	float Height = 0.0f;
+};
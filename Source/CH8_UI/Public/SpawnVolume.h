@@ -3,9 +3,29 @@
 #include "CoreMinimal.h"
 #include "GameFramework/Actor.h"
 #include "ItemSpawnRow.h"       // 우리가 정의한 구조체
+#include "NavigationSystemTypes.h"
+#include "SpawnRegionSampler.h"
 #include "SpawnVolume.generated.h"
 
 class UBoxComponent;
+class USplineComponent;
+class ANavigationData;
+
+// 스폰 지점을 뽑는 영역의 모양
+UENUM(BlueprintType)
+enum class ESpawnRegionShape : uint8
+{
+	// SpawningBox 안의 임의 지점
+	Box,
+	// SpawningSpline 을 따라 SplineWidth 폭의 띠 (스플라인 포인트 스케일 Y 로 구간별 폭 조절)
+	Spline,
+	// PolygonPoints 로 둘러싼 다각형
+	Polygon,
+	// SpawningBox 와 겹치는 내비메시 폴리곤
+	NavMesh
+};
+
+DECLARE_LOG_CATEGORY_EXTERN(LogSpawnVolume, Log, All);
 
 UCLASS()
 class CH8_UI_API ASpawnVolume : public AActor
@@ -17,16 +37,111 @@ public:
 	
 	UFUNCTION(BlueprintCallable, Category = "Spawning")
 	AActor* SpawnRandomItem(); // 리턴 형식을 AActor* 로 변경
+
+	// 스폰 확률에 따라 DataTable 행 하나를 고름 (스폰은 하지 않음)
+	const FItemSpawnRow* PickRandomItemRow() const { return GetRandomItem(); }
+	// 행의 아이템 클래스를 스폰하고 행의 효과 설정을 적용
+	AActor* SpawnItemFromRow(const FItemSpawnRow& Row);
+	AActor* SpawnItemFromRow(const FItemSpawnRow& Row, const FVector& Location);
+	// 검증된 후보 지점이 있으면 그중에서, 없으면(검증 전/실패) 볼륨 안 임의 지점
+	FVector GetRandomPointInVolume() const;
+	UDataTable* GetItemDataTable() const { return ItemDataTable; }
+
+	// 검증된 도달 가능 지점 (다음 웨이브 계획 태스크에 복사해 넘김)
+	const TArray<FVector>& GetReachablePoints() const { return ReachablePoints; }
+	// 스폰 상자의 월드 중심과 크기
+	void GetSpawnBox(FVector& OutOrigin, FVector& OutExtent) const;
+	// 상자 외 모양의 미리 만든 영역 (상자거나 아직 만들지 못했으면 null). 웨이브 계획 태스크와 공유
+	TSharedPtr<const FSpawnRegionSampler> GetSpawnRegion() const { return SpawnRegion; }
+	int32 GetNumRegionTriangles() const { return SpawnRegion ? SpawnRegion->GetNumTriangles() : 0; }
+	double GetLastRegionBuildMs() const { return LastRegionBuildMs; }
+	int32 GetNumReachablePoints() const { return ReachablePoints.Num(); }
+	int32 GetNumRejectedPoints() const { return NumRejectedPoints; }
+	double GetLastValidationMs() const { return LastValidationMs; }
+
+	// 플레이어 주변 고리 안의 기록만 액터로 만드는지 (USpawnRecordSubsystem 이 웨이브 시작 시 읽음)
+	bool UsesProximityRing() const { return bUseProximityRing; }
+	float GetMaterializeRadius() const { return MaterializeRadius; }
+	float GetDematerializeRadius() const { return FMath::Max(DematerializeRadius, MaterializeRadius); }
 	
 protected:
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category="Spawning")
 	USceneComponent* Scene;
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Spawning")
 	UBoxComponent* SpawningBox;
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Spawning")
+	USplineComponent* SpawningSpline;
 	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Spawning")
 	UDataTable* ItemDataTable;
 
+	// 스폰 영역 모양. 상자 외의 모양은 BeginPlay 에서 삼각형 면적 누적표로 한 번만 만들어 둠
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Spawning|Region")
+	ESpawnRegionShape RegionShape = ESpawnRegionShape::Box;
+	// 스플라인 띠의 폭
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Spawning|Region", meta = (EditCondition = "RegionShape == ESpawnRegionShape::Spline", ClampMin = "1"))
+	float SplineWidth = 600.0f;
+	// 스플라인을 삼각형 띠로 나누는 간격 (작을수록 곡선을 잘 따르지만 삼각형이 늘어남)
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Spawning|Region", meta = (EditCondition = "RegionShape == ESpawnRegionShape::Spline", ClampMin = "10"))
+	float SplineSampleSpacing = 200.0f;
+	// 다각형 꼭짓점 (액터 기준 좌표, 순서대로 연결. 자기 교차 없는 단순 다각형)
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Spawning|Region", meta = (EditCondition = "RegionShape == ESpawnRegionShape::Polygon", MakeEditWidget))
+	TArray<FVector> PolygonPoints;
+	// 상자 외 모양에서 표면 위로 띄울 최대 높이
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Spawning|Region", meta = (EditCondition = "RegionShape != ESpawnRegionShape::Box", ClampMin = "0"))
+	float RegionHeight = 0.0f;
+
+	// 후보 지점을 내비메시 위의 플레이어 시작 지점에서 실제로 갈 수 있는 곳으로 제한
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Spawning|Reachability")
+	bool bValidateReachability = true;
+	// 검증할 후보 지점 수. 웨이브마다 이 중에서 뽑음
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Spawning|Reachability", meta = (ClampMin = "1"))
+	int32 CandidateCount = 512;
+	// 후보를 내비메시에 투영할 때 탐색 범위
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Spawning|Reachability")
+	FVector ProjectionExtent = FVector(100.0f, 100.0f, 1000.0f);
+	// 내비메시 위로 이 높이까지는 점프로 닿는다고 보고 원래 높이를 유지
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Spawning|Reachability")
+	float MaxHeightAboveNavMesh = 150.0f;
+
+	// 넓은 볼륨용: 웨이브 아이템을 기록으로 두고 플레이어 근처의 것만 액터로 만듦
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Spawning|Proximity")
+	bool bUseProximityRing = false;
+	// 플레이어와 이 거리(XY) 안의 기록을 액터로 만듦
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Spawning|Proximity", meta = (EditCondition = "bUseProximityRing", ClampMin = "0"))
+	float MaterializeRadius = 4000.0f;
+	// 이 거리보다 멀어진 액터는 다시 기록으로 (경계에서 반복되지 않도록 MaterializeRadius 보다 크게)
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Spawning|Proximity", meta = (EditCondition = "bUseProximityRing", ClampMin = "0"))
+	float DematerializeRadius = 5000.0f;
+
+	virtual void BeginPlay() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
 	FItemSpawnRow* GetRandomItem() const;
-	AActor* SpawnItem(TSubclassOf<AActor> ItemClass);
-	FVector GetRandomPointInVolume() const;
+	AActor* SpawnItem(TSubclassOf<AActor> ItemClass, const FVector& Location);
+	FVector GetRandomPointInBox() const;
+	// 미리 만든 영역이 있으면 그 안, 없으면 상자 안 임의 지점
+	FVector GetRandomPointInRegion() const;
+	void BuildSpawnRegion();
+
+	void StartReachabilityValidation();
+	void OnCandidatePathFound(uint32 QueryId, ENavigationQueryResult::Type Result, FNavPathSharedPtr Path);
+	void FinishValidation();
+	UFUNCTION()
+	void OnNavigationGenerationFinished(ANavigationData* NavData);
+
+	// 검증이 끝난 도달 가능 지점 (내비메시가 다시 빌드될 때까지 모든 웨이브가 재사용)
+	TArray<FVector> ReachablePoints;
+	// GetRandomPointInVolume 의 비복원 추출 순서 (모든 지점을 한 번씩 쓴 뒤 다시 섞음)
+	mutable TArray<int32> ReachablePointOrder;
+	mutable int32 NextReachablePoint = 0;
+	// 진행 중인 비동기 경로 질의 → 후보 위치
+	TMap<uint32, FVector> PendingQueries;
+	TArray<FVector> ValidatingPoints;
+	int32 NumRejectedPoints = 0;
+	int32 ValidationRejects = 0;
+	double ValidationStartTime = 0.0;
+	double LastValidationMs = 0.0;
+
+	TSharedPtr<const FSpawnRegionSampler> SpawnRegion;
+	double LastRegionBuildMs = 0.0;
 };
\ No newline at end of file
@@ -0,0 +1,74 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "ItemEffectTypes.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "StatusEffectSubsystem.generated.h"
+
+class ACH8_UICharacter;
+
+/**
+ * 재생, 이동 속도 증가, 점수 배율, 독 같은 지속 효과 처리기.
+ * 효과 종류마다 대상/세기/남은 시간을 나란한 배열(SoA)로 보관하고, 프레임당 한 번 모든 효과를 진행시킨 뒤
+ * 대상별 합계를 캐릭터 체력·이동 속도와 점수 배율(GetScoreMultiplier)에 반영한다.
+ * 같은 효과를 여러 번 얻으면 항목이 따로 쌓이며, 만료된 항목은 배열 안에서 당겨 채워 제거한다.
+ */
+UCLASS()
+class CH8_UI_API UStatusEffectSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual bool ShouldCreateSubsystem(UObject* Outer) const override;
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+
+	static bool IsStatusEffect(EItemEffectType EffectType);
+
+	// EffectType 은 IsStatusEffect 인 종류만. Magnitude 의 의미는 EItemEffectType 참고
+	void AddEffect(EItemEffectType EffectType, ACH8_UICharacter* Target, float Magnitude, float Duration);
+	// 점수 아이템에 곱할 배율 (효과가 없으면 1)
+	float GetScoreMultiplier(const AActor* Target) const;
+	int32 GetNumActiveEffects() const;
+
+protected:
+	enum EStatusKind : uint8
+	{
+		Regeneration,
+		SpeedBoost,
+		ScoreMultiplier,
+		Poison,
+		NumKinds,
+	};
+
+	// 한 종류의 활성 효과들 (항목 i 는 세 배열의 i 번째)
+	struct FStatusEffectArrays
+	{
+		TArray<uint8> Targets;			// StatusTargets 인덱스
+		TArray<float> Magnitudes;
+		TArray<float> RemainingTimes;
+	};
+
+	// 효과를 받는 캐릭터와 프레임마다 계산되는 합계
+	struct FStatusTarget
+	{
+		TWeakObjectPtr<ACH8_UICharacter> Character;
+		float BaseWalkSpeed = 0.0f;
+		// 아직 적용하지 않은 체력 변화 (1 단위로 적용)
+		float PendingHealth = 0.0f;
+		float SpeedBonus = 0.0f;
+		float ScoreBonus = 0.0f;
+		float AppliedSpeedBonus = 0.0f;
+	};
+
+	static EStatusKind GetKind(EItemEffectType EffectType);
+	int32 FindOrAddTarget(ACH8_UICharacter* Character);
+	void AdvanceEffects(EStatusKind Kind, float DeltaTime);
+	void ApplyToTargets();
+
+	FStatusEffectArrays Effects[NumKinds];
+	TArray<FStatusTarget, TInlineAllocator<4>> StatusTargets;
+};
@@ -0,0 +1,40 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "WaveBalanceCommandlet.generated.h"
+
+class ABaseGameState;
+class UDataTable;
+struct FSimLevelItemMix;
+
+/**
+ * 웨이브 규칙(FWaveRules)을 헤드리스로 수천 번 돌려 레벨별 도달/클리어 비율과 점수 분포를 CSV 로 출력한다.
+ * 웨이브 설정은 GameStateClass 기본값, 아이템 구성은 레벨별 스폰 DataTable 에서 읽고 명령줄로 덮어쓸 수 있다.
+ * 사용법: UnrealEditor-Cmd CH8_UI.uproject -run=WaveBalance [-Runs=10000] [-Seed=1] [-ItemsPerWave=20,30,40]
+ *         [-WaveDurations=30,25,20] [-CoinSeconds=6] [-MineHitChance=0.3] [-HealChance=0.5] [-Out=<파일.csv>]
+ */
+UCLASS(config=Game)
+class CH8_UI_API UWaveBalanceCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+	UWaveBalanceCommandlet();
+
+	virtual int32 Main(const FString& Params) override;
+
+protected:
+	// 레벨 순서대로의 스폰 DataTable (ASpawnVolume::ItemDataTable 과 같은 테이블)
+	UPROPERTY(Config)
+	TArray<TSoftObjectPtr<UDataTable>> LevelItemTables;
+	// MaxLevels/MaxWaves/WaveDurations/ItemsPerWave 기본값을 읽을 게임 스테이트 클래스
+	UPROPERTY(Config)
+	TSoftClassPtr<ABaseGameState> GameStateClass;
+	UPROPERTY(Config)
+	int32 DefaultRuns = 10000;
+
+	bool BuildLevelItemMix(const UDataTable& SpawnTable, const UDataTable* EffectTable, FSimLevelItemMix& OutMix) const;
+};
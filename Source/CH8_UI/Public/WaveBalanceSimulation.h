@@ -0,0 +1,67 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "WaveRules.h"
+
+// 레벨 하나의 스폰 구성 (스폰 DataTable 의 SpawnChance 비율로 계산)
+struct FSimLevelItemMix
+{
+	float CoinChance = 0.0f;
+	float MineChance = 0.0f;
+	float HealChance = 0.0f;
+	// 코인 하나의 평균 점수 (SpawnChance 가중 평균)
+	float AverageCoinScore = 0.0f;
+	float MineDamage = 30.0f;
+	float HealAmount = 20.0f;
+};
+
+// 단순한 스크립트 플레이어 모델
+struct FSimPlayerModel
+{
+	// 코인이 하나 남았을 때 다음 코인까지 걸리는 평균 시간(초). 남은 코인이 n 개면 1/sqrt(n) 배
+	float NearestCoinSeconds = 6.0f;
+	// 아이템이 전부 지뢰일 때 코인 하나를 주우러 가다 지뢰를 밟을 확률
+	float MineHitChance = 0.3f;
+	// 아이템이 전부 회복 아이템일 때 코인 하나를 주우러 가다 회복 아이템을 먹을 확률
+	float HealPickupChance = 0.5f;
+	float MaxHealth = 100.0f;
+};
+
+// 한 번의 전체 플레이 결과
+struct FSimRunResult
+{
+	// 끝까지 클리어한 레벨 수
+	int32 LevelsCleared = 0;
+	// 실패한 레벨/웨이브 (클리어했으면 INDEX_NONE)
+	int32 FailedLevel = INDEX_NONE;
+	int32 FailedWave = INDEX_NONE;
+	bool bDied = false;
+	int32 TotalScore = 0;
+	float PlayTimeSeconds = 0.0f;
+	// 각 레벨을 끝낸 시점(클리어 또는 실패)의 누적 점수
+	TArray<int32, TInlineAllocator<4>> ScoreAtLevelEnd;
+};
+
+/**
+ * FWaveRules 를 실제 게임과 똑같이 구동하되, 스폰과 플레이어 이동은 확률 모델로 대신하는 헤드리스 시뮬레이션.
+ * 액터와 월드가 없으므로 스레드마다 독립적으로 수천 번 실행할 수 있다.
+ */
+namespace WaveBalanceSimulation
+{
+	CH8_UI_API FSimRunResult SimulateRun(
+		const FWaveRulesConfig& Config,
+		TConstArrayView<FSimLevelItemMix> Levels,
+		const FSimPlayerModel& Player,
+		FRandomStream& Random);
+
+	// NumRuns 번을 모든 코어에서 병렬로 실행. 결과는 실행 순서와 무관하게 Seed 로 재현 가능
+	CH8_UI_API void SimulateRuns(
+		const FWaveRulesConfig& Config,
+		TConstArrayView<FSimLevelItemMix> Levels,
+		const FSimPlayerModel& Player,
+		int32 NumRuns,
+		int32 Seed,
+		TArray<FSimRunResult>& OutResults);
+}
@@ -0,0 +1,89 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+// 웨이브/레벨 규칙 설정. ABaseGameState 의 Level/Wave 프로퍼티와 같은 의미
+struct CH8_UI_API FWaveRulesConfig
+{
+	int32 MaxLevels = 3;
+	int32 MaxWaves = 3;
+	TArray<float> WaveDurations;
+	TArray<int32> ItemsPerWave;
+
+	// 배열에 값이 없는 웨이브에 쓰는 기본값
+	int32 DefaultItemsPerWave = 40;
+	float DefaultWaveDuration = 30.0f;
+
+	int32 GetItemsForWave(int32 WaveIndex) const
+	{
+		return ItemsPerWave.IsValidIndex(WaveIndex) ? ItemsPerWave[WaveIndex] : DefaultItemsPerWave;
+	}
+
+	float GetWaveDuration(int32 WaveIndex) const
+	{
+		return WaveDurations.IsValidIndex(WaveIndex) ? WaveDurations[WaveIndex] : DefaultWaveDuration;
+	}
+};
+
+// 규칙 호출 결과로 다음에 해야 할 일
+enum class EWaveRulesStep : uint8
+{
+	None,			// 진행 중
+	WaveCleared,	// 웨이브의 코인을 모두 모음 → AdvanceWave
+	NextWave,		// 같은 레벨의 다음 웨이브 시작
+	LevelCleared,	// 레벨의 마지막 웨이브 클리어 → AdvanceLevel
+	NextLevel,		// 다음 레벨 맵으로 이동
+	GameCleared,	// 마지막 레벨까지 클리어
+	GameOver,		// 시간 초과 또는 사망
+};
+
+/**
+ * 액터, 타이머, 월드에 의존하지 않는 웨이브/점수/레벨 규칙.
+ * ABaseGameState 가 실제 게임에서 구동하고, 밸런스 시뮬레이터(WaveBalanceSimulation)가 헤드리스로 구동한다.
+ * 스폰과 시간 측정은 호출하는 쪽의 책임이고, 이 클래스는 카운터와 상태 전이만 다룬다.
+ */
+class CH8_UI_API FWaveRules
+{
+public:
+	void Configure(const FWaveRulesConfig& InConfig);
+	const FWaveRulesConfig& GetConfig() const { return Config; }
+
+	// 레벨 시작. 웨이브는 0번부터
+	void StartLevel(int32 InLevelIndex);
+	// 현재 웨이브 시작. SpawnedCoins 는 실제로 스폰된 코인 수
+	void StartWave(int32 InSpawnedCoins);
+	// 코인 획득. 웨이브의 코인을 모두 모으면 WaveCleared
+	EWaveRulesStep CollectCoins(int32 Count);
+	// WaveCleared 이후 호출. NextWave 또는 LevelCleared
+	EWaveRulesStep AdvanceWave();
+	// LevelCleared 이후 호출. NextLevel 또는 GameCleared
+	EWaveRulesStep AdvanceLevel();
+	// 웨이브 시간 초과, 사망
+	EWaveRulesStep FailWave();
+	// 모으기 전에 사라진 코인(수명 만료)을 필요 코인 수에서 뺌. 남은 코인을 모두 모은 상태가 되면 WaveCleared
+	EWaveRulesStep ExpireCoins(int32 Count);
+
+	void AddScore(int32 Amount) { Score += Amount; }
+
+	int32 GetLevelIndex() const { return LevelIndex; }
+	int32 GetWaveIndex() const { return WaveIndex; }
+	int32 GetSpawnedCoins() const { return SpawnedCoins; }
+	int32 GetCollectedCoins() const { return CollectedCoins; }
+	int32 GetScore() const { return Score; }
+	int32 GetItemsForCurrentWave() const { return Config.GetItemsForWave(WaveIndex); }
+	float GetCurrentWaveDuration() const { return Config.GetWaveDuration(WaveIndex); }
+	bool IsWaveActive() const { return bWaveActive; }
+	bool IsGameCleared() const { return bGameCleared; }
+
+private:
+	FWaveRulesConfig Config;
+	int32 LevelIndex = 0;
+	int32 WaveIndex = 0;
+	int32 SpawnedCoins = 0;
+	int32 CollectedCoins = 0;
+	int32 Score = 0;
+	bool bWaveActive = false;
+	bool bGameCleared = false;
+};
@@ -0,0 +1,92 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "Tasks/Task.h"
+#include "WaveSpawnPlannerSubsystem.generated.h"
+
+class ASpawnVolume;
+struct FItemSpawnRow;
+class FSpawnRegionSampler;
+
+DECLARE_LOG_CATEGORY_EXTERN(LogWavePlanner, Log, All);
+
+// 한 웨이브에 스폰할 아이템 행과 위치, 완료에 필요한 코인 수
+struct FWaveSpawnPlan
+{
+	int32 LevelIndex = INDEX_NONE;
+	int32 WaveIndex = INDEX_NONE;
+	TArray<const FItemSpawnRow*> Rows;
+	TArray<FVector> Locations;
+	int32 CoinCount = 0;
+};
+
+/**
+ * 다음 웨이브의 스폰 계획(아이템 종류, 위치, 코인 수)을 현재 웨이브가 진행되는 동안 워커 태스크에서 미리 계산한다.
+ * 계획은 이중 버퍼로, 게임 스레드는 앞 버퍼만 읽고 태스크는 뒤 버퍼에만 쓴다. 태스크가 끝난 뒤 AcquirePlan 에서 버퍼를 뒤집는다.
+ * 태스크 입력(행 가중치, 코인 여부, 후보 지점)은 요청 시점에 게임 스레드에서 복사하므로 태스크는 UObject 에 접근하지 않는다.
+ * 입력도 계획과 같이 이중 버퍼이며, 배열은 웨이브마다 비우기만 해서 준비 웨이브 이후에는 힙 할당이 없다.
+ * 웨이브 시작 시 계획이 아직 없거나 다른 웨이브용이면 같은 계산을 게임 스레드에서 바로 하고 대체 횟수를 센다.
+ */
+UCLASS()
+class CH8_UI_API UWaveSpawnPlannerSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual bool ShouldCreateSubsystem(UObject* Outer) const override;
+	virtual void Deinitialize() override;
+
+	// 웨이브 시작 직후 호출. 다음 웨이브 계획을 워커 태스크에서 계산 시작
+	void RequestPlan(ASpawnVolume* SpawnVolume, int32 LevelIndex, int32 WaveIndex, int32 ItemCount);
+	// 웨이브 시작 시 호출. 미리 계산된 계획이 맞으면 그대로, 아니면 지금 계산한 계획. 다음 RequestPlan 이후에도 유효
+	const FWaveSpawnPlan& AcquirePlan(ASpawnVolume* SpawnVolume, int32 LevelIndex, int32 WaveIndex, int32 ItemCount);
+
+	int32 GetNumPrecomputed() const { return NumPrecomputed; }
+	// 요청한 계획이 웨이브 시작까지 끝나지 않았거나 맞지 않아서 게임 스레드에서 계산한 횟수
+	int32 GetNumFallbacks() const { return NumFallbacks; }
+	// 요청 없이 시작한 웨이브 (레벨의 첫 웨이브, 디버그 건너뛰기)
+	int32 GetNumUnplanned() const { return NumUnplanned; }
+	double GetLastPlanMs() const { return LastPlanMs; }
+
+protected:
+	// 태스크가 읽는 입력의 복사본
+	struct FPlanInputs
+	{
+		int32 LevelIndex = INDEX_NONE;
+		int32 WaveIndex = INDEX_NONE;
+		int32 ItemCount = 0;
+		int32 Seed = 0;
+		TArray<const FItemSpawnRow*> Rows;
+		// 행별 누적 스폰 확률
+		TArray<float> CumulativeChance;
+		TBitArray<> CoinRows;
+		// 검증된 도달 가능 지점. 없으면 영역(없으면 상자) 안 임의 지점
+		TArray<FVector> ReachablePoints;
+		TSharedPtr<const FSpawnRegionSampler> Region;
+		FVector BoxOrigin = FVector::ZeroVector;
+		FVector BoxExtent = FVector::ZeroVector;
+	};
+
+	bool MakeInputs(ASpawnVolume* SpawnVolume, int32 LevelIndex, int32 WaveIndex, int32 ItemCount, FPlanInputs& OutInputs) const;
+	// Inputs.ReachablePoints 는 계획마다 복사한 것이라 뽑으면서 제자리에서 섞음
+	static void BuildPlan(FPlanInputs& Inputs, FWaveSpawnPlan& OutPlan, double& OutMs);
+	void WaitForTask();
+
+	FWaveSpawnPlan Plans[2];
+	// Plans 와 같은 인덱스의 입력. 뒤 버퍼 입력은 태스크가 읽는 중일 수 있음
+	FPlanInputs PlanInputs[2];
+	int32 FrontIndex = 0;
+	UE::Tasks::FTask PlanTask;
+	// 태스크가 계산 중인 계획의 대상 볼륨
+	TWeakObjectPtr<ASpawnVolume> PlannedVolume;
+	int32 PlannedItemCount = 0;
+	double BackPlanMs = 0.0;
+
+	int32 NumPrecomputed = 0;
+	int32 NumFallbacks = 0;
+	int32 NumUnplanned = 0;
+	double LastPlanMs = 0.0;
+};
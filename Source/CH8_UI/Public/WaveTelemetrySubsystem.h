@@ -0,0 +1,52 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "WaveTelemetrySubsystem.generated.h"
+
+DECLARE_LOG_CATEGORY_EXTERN(LogWaveTelemetry, Log, All);
+
+// 웨이브 시작/종료 시점의 메모리, 오브젝트 스냅샷
+struct FWaveTelemetrySnapshot
+{
+	double Time = 0.0;
+	int32 UObjectCount = 0;
+	int32 ComponentCount = 0;
+	int32 LiveItemCount = 0;
+	// ItemType 별 살아있는 ABaseItem 수
+	TMap<FName, int32> ItemCounts;
+	// CH8LLM::TagNames 순서와 동일
+	TArray<int64, TInlineAllocator<4>> LLMTagAmounts;
+};
+
+/**
+ * 웨이브 단위 메모리/오브젝트 수 리포트.
+ * ABaseGameState 가 웨이브 시작/종료 시 호출하며, 결과는 Saved/Telemetry/WaveTelemetry.csv 에 누적된다.
+ * 렌더링에 의존하지 않으므로 -nullrhi 헤드리스 실행에서도 동작한다.
+ */
+UCLASS()
+class CH8_UI_API UWaveTelemetrySubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual bool ShouldCreateSubsystem(UObject* Outer) const override;
+
+	// 웨이브 스폰이 끝난 직후 호출
+	void BeginWave(int32 LevelIndex, int32 WaveIndex);
+	// 웨이브가 끝날 때 호출 (Outcome: Cleared, TimeUp, GameOver 등)
+	void EndWave(const TCHAR* Outcome);
+
+	static FString GetReportFilePath();
+
+protected:
+	void CaptureSnapshot(FWaveTelemetrySnapshot& OutSnapshot) const;
+	void WriteRow(const TCHAR* Outcome, const FWaveTelemetrySnapshot& EndSnapshot) const;
+
+	bool bWaveActive = false;
+	int32 ActiveLevelIndex = 0;
+	int32 ActiveWaveIndex = 0;
+	FWaveTelemetrySnapshot StartSnapshot;
+};